@@ -0,0 +1,43 @@
+#include <ssd1306.hpp>
+#include <ssd1306/sim.hpp>
+
+#include <cstdio>
+
+using namespace ssd1306;
+using namespace ssd1306::sim;
+
+/** This demo runs the driver on a Linux box. The mock pins 'pb0' and
+    'pb2' are watched by a virtual SSD1306 that decodes the I2C bus
+    and emulates the controller with its GDDRAM. The cost of each call
+    is reported as bus clocks and the frame is printed at the end.
+*/
+
+template<typename F>
+void measure(const char* what, virtual_display<pb0_t, pb2_t>& panel, F f) {
+    auto before = panel.stats();
+    f();
+    auto cost = panel.stats() - before;
+    std::printf("%-28s starts=%-3u bytes=%-5u clocks=%u\n",
+                what, cost.starts, cost.bytes, cost.clocks);
+}
+
+int main() {
+    virtual_display<pb0_t, pb2_t> panel;
+
+    auto before = panel.stats();
+    display<pb0_t, pb2_t> disp{pb0, pb2, turn_on{}};
+    auto init = panel.stats() - before;
+    std::printf("%-28s starts=%-3u bytes=%-5u clocks=%u\n",
+                "display{pb0, pb2, turn_on}", init.starts, init.bytes,
+                init.clocks);
+
+    measure("out<20, 32>(-1234)", panel, [&]{
+        disp.out<20, 32>(page{0, 3}, column{0, 127}, -1234);
+    });
+
+    measure("out(page, column, 0xff, rep)", panel, [&]{
+        disp.out(page{6, 7}, column{0, 63}, uint8_t(0xff), repeat<uint8_t>{128});
+    });
+
+    std::fputs(panel.ctrl().ascii().c_str(), stdout);
+}
@@ -100,7 +100,10 @@ static const bitmap_90_clockwise letter_i [[gnu::__progmem__]] = toGDDRAM(bitmap
  */
 
 int main() {
-    ssd1306::i2c dev{pb0, pb2};
+    //PB0 and PB2 declare their port, so SDA and SCL are written
+    //together, take a look at 'port_pin'
+    ssd1306::i2c dev{port_pin<attiny85_portb, 0>{},
+                     port_pin<attiny85_portb, 2>{}};
 
     /** setup the display */
     dev.start_commands();
@@ -14,7 +14,10 @@ int main() {
         'ssd1306/i2c.hpp' to know more about how to initilize
         'ssd1306::i2c'.
      */
-    ssd1306::i2c dev{pb0, pb2};
+    //PB0 and PB2 declare their port, so SDA and SCL are written
+    //together, take a look at 'port_pin'
+    ssd1306::i2c dev{port_pin<attiny85_portb, 0>{},
+                     port_pin<attiny85_portb, 2>{}};
 
     /** The first operation to send a command is to initiate the
         communication by a start condition. The start condition is
@@ -1,5 +1,20 @@
 #pragma once
 
+#include "ssd1306/animation.hpp"
+#include "ssd1306/async_bus.hpp"
+#include "ssd1306/band_renderer.hpp"
+#include "ssd1306/console.hpp"
 #include "ssd1306/display.hpp"
+#include "ssd1306/external_memory.hpp"
+#include "ssd1306/font.hpp"
+#include "ssd1306/hw_i2c.hpp"
 #include "ssd1306/i2c.hpp"
+#include "ssd1306/multi_i2c.hpp"
+#include "ssd1306/numeric_field.hpp"
+#include "ssd1306/packbits.hpp"
+#include "ssd1306/panel_scheduler.hpp"
+#include "ssd1306/port_pin.hpp"
+#include "ssd1306/sliced_renderer.hpp"
+#include "ssd1306/spi.hpp"
+#include "ssd1306/transaction_planner.hpp"
 
@@ -0,0 +1,267 @@
+#pragma once
+
+#include "ssd1306/detail/progmem.hpp"
+#include "ssd1306/packbits.hpp"
+#include "ssd1306/set_page_column.hpp"
+
+#include <stdint.h>
+
+namespace ssd1306 {
+
+/** Deltas of an animation in the program memory
+
+    The bytes are a sequence of deltas. Each delta starts with the
+    number of windows and each window has four bytes followed by its
+    data:
+
+    - the start page, with the bit 7 set if the data is compressed
+      with PackBits(take a look at 'ssd1306/packbits.hpp');
+    - the end page, the start column and the end column;
+    - the bytes of the window in the order of the vertical addressing
+      mode, raw or compressed.
+
+    bytes: first delta, which draws the first frame on a clear screen.
+    loop: second delta, where the playback restarts after the last
+          one, which returns to the first frame.
+    end: end of the last delta.
+    frames: number of frames.
+*/
+struct animation_span {
+    const uint8_t* bytes;
+    const uint8_t* loop;
+    const uint8_t* end;
+    uint8_t frames;
+};
+
+namespace detail {
+
+//Bus bytes of the commands and of the transactions of one window.
+constexpr uint8_t window_cost{10};
+
+constexpr uint8_t page_count(uint8_t mask) {
+    uint8_t first{8}, last{0};
+    for(uint8_t p{0}; p < 8; ++p)
+        if(mask >> p & 1) {
+            if(first == 8) first = p;
+            last = p;
+        }
+    return first == 8 ? 0 : last - first + 1;
+}
+
+constexpr uint8_t changed_pages(const uint8_t* prev, const uint8_t* cur,
+                                uint8_t col)
+{
+    uint8_t mask{0};
+    for(uint8_t p{0}; p < 8; ++p) {
+        uint8_t before = prev ? prev[col * 8 + p] : 0x00;
+        if(before != cur[col * 8 + p]) mask |= 1 << p;
+    }
+    return mask;
+}
+
+/** Calls f(mask, c0, c1) to each window of the delta from 'prev' to
+    'cur'. A null 'prev' is a clear screen.
+
+    The columns with changes are grouped in runs and the pages of a
+    window are the ones between the first and the last page that
+    changed in its columns. Two neighbour windows are merged when the
+    unchanged bytes of the merged window cost less than a new
+    window. */
+template<typename F>
+constexpr void for_each_window(const uint8_t* prev, const uint8_t* cur,
+                               F f)
+{
+    uint8_t mask{0}, c0{0}, c1{0};
+    for(uint8_t c{0}; c < 128;) {
+        uint8_t m = changed_pages(prev, cur, c);
+        if(!m) { ++c; continue; }
+        uint8_t s0{c}, sm{0};
+        for(; c < 128 && (m = changed_pages(prev, cur, c)); ++c) sm |= m;
+        uint8_t s1 = c - 1;
+        if(mask) {
+            uint16_t merged = (s1 - c0 + 1) * page_count(mask | sm);
+            uint16_t apart = (c1 - c0 + 1) * page_count(mask)
+                + (s1 - s0 + 1) * page_count(sm) + window_cost;
+            if(merged <= apart) {
+                mask |= sm;
+                c1 = s1;
+                continue;
+            }
+            f(mask, c0, c1);
+        }
+        mask = sm;
+        c0 = s0;
+        c1 = s1;
+    }
+    if(mask) f(mask, c0, c1);
+}
+
+/** Bytes of a window of a frame in the order of the vertical
+    addressing mode. */
+struct window_bytes {
+    const uint8_t* frame;
+    uint8_t p0, pages, c0;
+
+    constexpr uint8_t operator[](uint16_t i) const
+    { return frame[(c0 + i / pages) * 8 + p0 + i % pages]; }
+};
+
+/** Encodes the deltas of 'n' frames calling out(pos, byte) to each
+    byte. Returns the size. 'loop' receives the position of the second
+    delta. */
+template<typename Out>
+constexpr uint32_t animation_encode(const uint8_t* const* frames, uint8_t n,
+                                    uint32_t& loop, Out out)
+{
+    uint32_t pos{0};
+    for(uint16_t k{0}; k <= n; ++k) {
+        if(k == 1) loop = pos;
+        const uint8_t* prev = k ? frames[k - 1] : nullptr;
+        const uint8_t* cur = frames[k % n];
+        uint8_t count{0};
+        for_each_window(prev, cur, [&](uint8_t, uint8_t, uint8_t)
+                        { ++count; });
+        out(pos++, count);
+        for_each_window(prev, cur, [&](uint8_t mask, uint8_t c0, uint8_t c1){
+            uint8_t p0{0};
+            while(!(mask >> p0 & 1)) ++p0;
+            uint8_t pages = page_count(mask);
+            window_bytes in{cur, p0, pages, c0};
+            uint16_t raw = (c1 - c0 + 1) * pages;
+            uint16_t packed =
+                packbits_encode(in, raw, [](uint16_t, uint8_t){});
+            bool compress = packed < raw;
+            out(pos++, uint8_t(p0 | (compress ? 0x80 : 0)));
+            out(pos++, uint8_t(p0 + pages - 1));
+            out(pos++, c0);
+            out(pos++, c1);
+            if(compress) {
+                uint32_t base = pos;
+                packbits_encode(in, raw, [&](uint16_t i, uint8_t b)
+                                { out(base + i, b); });
+                pos += packed;
+            } else
+                for(uint16_t i{0}; i < raw; ++i) out(pos++, in[i]);
+        });
+    }
+    return pos;
+}
+
+} //namespace detail
+
+/** Animation encoded at compile time as deltas between frames
+
+    Only the windows that change from one frame to the next are
+    stored, each one compressed with PackBits when it's smaller. The
+    player sends each window with its own column and page
+    addresses(0x21/0x22), so the bus time of a frame depends on the
+    amount of motion instead of on the size of the screen.
+
+    Frames: constexpr arrays with static storage with 1024 bytes of a
+            whole screen in the order of the vertical addressing mode:
+            the byte 'col * 8 + page'. The arrays are only read by the
+            compiler.
+
+    Example:
+
+      constexpr uint8_t f0[1024] = {...}, f1[1024] = {...};
+      animation_player boot{animation<f0, f1>::span()};
+      while(true) {
+          boot.next(disp.device());
+          wait_frame();
+      }
+*/
+template<const auto&... Frames>
+struct animation {
+    static_assert(sizeof...(Frames) >= 1 && sizeof...(Frames) < 0xff, "");
+    static_assert(((sizeof(Frames) == 1024) && ...),
+                  "each frame must have 1024 bytes");
+    static constexpr uint8_t frames{sizeof...(Frames)};
+private:
+    struct layout_t { uint32_t size, loop; };
+
+    static constexpr layout_t layout() {
+        const uint8_t* ptrs[] = {Frames...};
+        layout_t r{0, 0};
+        r.size = detail::animation_encode(ptrs, frames, r.loop,
+                                          [](uint32_t, uint8_t){});
+        return r;
+    }
+
+    static constexpr layout_t _layout{layout()};
+    static_assert(_layout.size <= 0xffff, "the animation is too large");
+public:
+    static constexpr uint16_t size{uint16_t(_layout.size)};
+
+    struct bytes_t { uint8_t value[size]; };
+private:
+    static constexpr bytes_t make() {
+        const uint8_t* ptrs[] = {Frames...};
+        bytes_t r{};
+        uint32_t loop{0};
+        detail::animation_encode(ptrs, frames, loop,
+                                 [&](uint32_t i, uint8_t b)
+                                 { r.value[i] = b; });
+        return r;
+    }
+public:
+    static const bytes_t bytes;
+
+    static animation_span span() {
+        return {bytes.value, bytes.value + _layout.loop,
+                bytes.value + size, frames};
+    }
+};
+
+template<const auto&... Frames>
+const typename animation<Frames...>::bytes_t animation<Frames...>::bytes
+SSD1306_PROGMEM = animation<Frames...>::make();
+
+/** Player of an 'animation'
+
+    next() sends the delta to the next frame. The first call draws the
+    first frame and the frames are repeated after the last one.
+
+    precondition: the device is using the vertical addressing mode,
+    the screen is clear before the first call and the region of the
+    animation isn't changed by anything else.
+*/
+class animation_player {
+    animation_span _a;
+    const uint8_t* _p;
+    uint8_t _frame{0xff};
+public:
+    explicit animation_player(const animation_span& a) : _a(a), _p(a.bytes)
+    {}
+
+    /** Frame on the screen, or 0xff before the first call to
+        next(). */
+    uint8_t frame() const { return _frame; }
+
+    /** Sends the delta to the next frame, one window after the other.
+        Returns the frame on the screen. */
+    template<typename Bus>
+    uint8_t next(Bus&& bus) {
+        if(_p == _a.end) _p = _a.loop;
+        uint8_t count = detail::read_flash(_p++);
+        for(; count; --count) {
+            uint8_t p0 = detail::read_flash(_p++);
+            uint8_t p1 = detail::read_flash(_p++);
+            uint8_t c0 = detail::read_flash(_p++);
+            uint8_t c1 = detail::read_flash(_p++);
+            bool compressed = p0 & 0x80;
+            p0 &= 0x7f;
+            uint16_t raw = uint16_t(p1 - p0 + 1) * (c1 - c0 + 1);
+            set(bus, page{p0, p1}, column{c0, c1});
+            bus.start_data();
+            if(compressed) _p = detail::send_packets(bus, _p, raw);
+            else
+                for(; raw; --raw) bus.send_byte(detail::read_flash(_p++));
+            bus.stop_condition();
+        }
+        _frame = _frame + 1 < _a.frames ? _frame + 1 : 0;
+        return _frame;
+    }
+};
+
+}
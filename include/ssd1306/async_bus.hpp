@@ -0,0 +1,212 @@
+#pragma once
+
+#include "ssd1306/detail/progmem.hpp"
+#include "ssd1306/i2c.hpp"
+#include "ssd1306/set_page_column.hpp"
+
+#include <stdint.h>
+
+namespace ssd1306 {
+
+/** One transaction of commands or data that is sent by 'async_bus'
+
+    The bytes come from one of four sources:
+
+    - ram: a span in RAM, which must live until the transfer is done;
+    - flash: a span defined with SSD1306_PROGMEM;
+    - fill: one byte repeated 'size' times;
+    - local: up to six bytes stored in the descriptor, like the
+      commands of a window.
+
+    'done' is an optional function that is called after the stop
+    condition of the transfer. It's called by step(), so it runs in
+    the context of the interrupt that drives the bus.
+*/
+struct transfer {
+    enum class source : uint8_t { ram, flash, fill, local };
+
+    dc mode;
+    source src;
+    uint16_t size;
+    union {
+        const uint8_t* bytes;
+        uint8_t byte;
+        uint8_t local[6];
+    };
+    void (*done)();
+
+    static transfer ram(dc mode, const uint8_t* bytes, uint16_t size,
+                        void (*done)() = nullptr)
+    {
+        transfer t{mode, source::ram, size, {}, done};
+        t.bytes = bytes;
+        return t;
+    }
+
+    static transfer flash(dc mode, const uint8_t* bytes, uint16_t size,
+                          void (*done)() = nullptr)
+    {
+        transfer t{mode, source::flash, size, {}, done};
+        t.bytes = bytes;
+        return t;
+    }
+
+    /** 'count' data bytes with the value 'byte'. */
+    static transfer fill(uint8_t byte, uint16_t count,
+                         void (*done)() = nullptr)
+    {
+        transfer t{dc::data, source::fill, count, {}, done};
+        t.byte = byte;
+        return t;
+    }
+
+    /** Commands 0x22 and 0x21 that set the window. */
+    static transfer window(page pg, column col, void (*done)() = nullptr) {
+        transfer t{dc::command, source::local, 6, {}, done};
+        t.local[0] = 0x22;
+        t.local[1] = pg.start;
+        t.local[2] = pg.end;
+        t.local[3] = 0x21;
+        t.local[4] = col.start;
+        t.local[5] = col.end;
+        return t;
+    }
+
+    uint8_t at(uint16_t i) const {
+        switch(src) {
+        case source::ram: return bytes[i];
+        case source::flash: return detail::read_flash(bytes + i);
+        case source::fill: return byte;
+        default: return local[i];
+        }
+    }
+};
+
+namespace detail {
+
+//The stores to a descriptor can't be moved after the store of the
+//counter that publishes it to the interrupt.
+inline void compiler_barrier()
+{ __atomic_signal_fence(__ATOMIC_SEQ_CST); }
+
+}
+
+/** Asynchronous transmission of transfers through a ring buffer
+
+    The main loop pushes descriptors and an interrupt, usually from a
+    timer, calls step(), which sends one piece of the transfer at the
+    head of the queue: the start of the transaction(start_commands()
+    or start_data()) or one byte. The last byte of a transfer is
+    followed by the stop condition in the same step. The time that
+    the interrupt takes is bounded by one step, so the main loop keeps
+    running while a large transfer, like a clear of the screen, is
+    sent.
+
+    push() returns false when the queue is full, which is the
+    back-pressure to the producer. Each transfer has a ticket, the
+    value of pushed() after its push, and done(ticket) tells if it
+    was sent. The tickets are bytes, so a ticket is valid until 255
+    transfers are pushed after it. A callback can also be attached to
+    a transfer.
+
+    The queue is shared by the main loop and one interrupt without
+    disabling the interrupts: the main loop only writes the counter of
+    pushed transfers and the interrupt only writes the counter of
+    completed ones. Both are bytes, which are read and written
+    atomically by the AVR.
+
+    Bus: transport with the static operations start_commands(),
+         start_data(), send_byte() and stop_condition(), like 'i2c',
+         'twi_i2c' or 'spi'. It must not be used by other code while
+         the queue isn't empty.
+    Capacity: number of descriptors. It's a power of two up to 64.
+              Each descriptor has 12 bytes on the AVR.
+
+    Example:
+
+      async_bus<i2c<pb0_t, pb2_t>> q;
+      ISR(TIMER0_COMPA_vect) { q.step(); }
+
+      q.push(transfer::window(page{0, 7}, column{0, 127}));
+      q.push(transfer::fill(0x00, 128 * 8));
+      auto t = q.pushed();
+      while(!q.done(t)) sample_sensors();
+*/
+template<typename Bus, uint8_t Capacity = 8>
+class async_bus {
+    static_assert(Capacity >= 1 && Capacity <= 64
+                  && !(Capacity & (Capacity - 1)), "");
+    static constexpr uint8_t mask{Capacity - 1};
+
+    transfer _q[Capacity];
+    volatile uint8_t _pushed{0}, _completed{0};
+    uint16_t _pos{0};
+    bool _open{false};
+public:
+    using ticket = uint8_t;
+
+    static constexpr uint8_t capacity{Capacity};
+
+    /** Number of transfers in the queue, including the one that is
+        being sent. */
+    uint8_t size() const { return uint8_t(_pushed - _completed); }
+
+    bool empty() const { return _pushed == _completed; }
+
+    bool full() const { return size() == Capacity; }
+
+    /** Enqueues a transfer. Returns false if the queue is full. */
+    bool push(const transfer& t) {
+        if(full()) return false;
+        _q[_pushed & mask] = t;
+        detail::compiler_barrier();
+        _pushed = _pushed + 1;
+        return true;
+    }
+
+    /** Ticket of the last pushed transfer. */
+    ticket pushed() const { return _pushed; }
+
+    /** True if the transfer with the ticket 't' was sent, which
+        means that it isn't one of the pending ones: the tickets
+        between the completed transfers and pushed(). The result is
+        right while less than 256 transfers were pushed after 't',
+        regardless of the number of completions. */
+    bool done(ticket t) const {
+        uint8_t pushed = _pushed;
+        return uint8_t(pushed - t) >= uint8_t(pushed - _completed);
+    }
+
+    /** Sends the next piece of the transfer at the head of the queue.
+        Returns false if there wasn't anything to send.
+
+        It's called by the interrupt or by the main loop, never by
+        both. */
+    bool step() {
+        uint8_t head = _completed;
+        if(head == _pushed) return false;
+        detail::compiler_barrier();
+        const transfer& t = _q[head & mask];
+        if(!_open) {
+            if(t.mode == dc::command) Bus::start_commands();
+            else Bus::start_data();
+            _open = true;
+            _pos = 0;
+            if(t.size) return true;
+        } else Bus::send_byte(t.at(_pos++));
+        if(_pos == t.size) {
+            Bus::stop_condition();
+            _open = false;
+            auto f = t.done;
+            detail::compiler_barrier();
+            _completed = head + 1;
+            if(f) f();
+        }
+        return true;
+    }
+
+    /** Sends everything that is in the queue. */
+    void flush() { while(step()); }
+};
+
+}
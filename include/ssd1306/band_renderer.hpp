@@ -0,0 +1,235 @@
+#pragma once
+
+#include "ssd1306/detail/window_cursor.hpp"
+#include "ssd1306/set_page_column.hpp"
+
+#include <stdint.h>
+
+namespace ssd1306 {
+
+/** Small piece of the screen in the MCU RAM
+
+    A band has 'Pages' pages and 'Columns' columns and it's placed at
+    any page and column of the screen. The bytes use the layout of the
+    vertical addressing mode. Writes outside of the band are ignored,
+    this allows a draw operation to be replayed for each band without
+    knowing where the band is.
+
+    For example, a band<1, 32> uses only 32 bytes of RAM and it's
+    enough to render a screen of 128x64 dots with 32 bands.
+*/
+template<uint8_t Pages, uint8_t Columns = 128>
+class band {
+    static_assert(Pages >= 1 && Pages <= 8, "");
+    static_assert(Columns >= 1 && Columns <= 128, "");
+    uint8_t _buf[Pages * Columns];
+    uint8_t _page0{0}, _col0{0}, _pages{Pages}, _cols{Columns};
+public:
+    static constexpr uint8_t pages{Pages};
+    static constexpr uint8_t columns{Columns};
+
+    /** Moves the band to the page 'pg' and column 'col' and clears
+        it. The band is shortened to 'npages' and 'ncols' when it's
+        the last one of a region. */
+    void place(uint8_t pg, uint8_t col,
+               uint8_t npages = Pages, uint8_t ncols = Columns)
+    {
+        _page0 = pg;
+        _col0 = col;
+        _pages = npages;
+        _cols = ncols;
+        for(auto& b : _buf) b = 0x00;
+    }
+
+    uint8_t first_page() const { return _page0; }
+    uint8_t last_page() const { return _page0 + _pages - 1; }
+    uint8_t first_column() const { return _col0; }
+    uint8_t last_column() const { return _col0 + _cols - 1; }
+
+    bool contains(uint8_t pg, uint8_t col) const {
+        return uint8_t(pg - _page0) < _pages
+            && uint8_t(col - _col0) < _cols;
+    }
+
+    /** True if the region intersects the band. */
+    bool intersects(page pg, column col) const {
+        return pg.start <= last_page() && pg.end >= _page0
+            && col.start <= last_column() && col.end >= _col0;
+    }
+
+    /** Writes a byte at the page 'pg' and column 'col' of the screen. */
+    void put(uint8_t pg, uint8_t col, uint8_t byte) {
+        if(contains(pg, col))
+            _buf[uint8_t(col - _col0) * _pages + uint8_t(pg - _page0)] = byte;
+    }
+
+    /** Combines a byte with the one at the page 'pg' and column 'col'
+        of the screen using OR. */
+    void merge(uint8_t pg, uint8_t col, uint8_t byte) {
+        if(contains(pg, col))
+            _buf[uint8_t(col - _col0) * _pages + uint8_t(pg - _page0)] |= byte;
+    }
+
+    /** Turns on the dot at the column 'x' and row 'y' of the screen. */
+    void dot(uint8_t x, uint8_t y) { merge(y / 8, x, 1 << (y % 8)); }
+
+    /** Sends the band to the device using one data transaction. */
+    template<typename I2C>
+    void send(I2C&& i2c) const {
+        set(i2c, page{_page0, last_page()}, column{_col0, last_column()});
+        i2c.start_data();
+        for(uint16_t i{}; i < uint16_t(_pages) * _cols; ++i)
+            i2c.send_byte(_buf[i]);
+        i2c.stop_condition();
+    }
+};
+
+/** Draw operations
+
+    A draw operation is a callable that receives a band and draws its
+    piece of the element, it's called once to each band. All of them
+    combine the dots with the ones that are already in the band using
+    OR.
+*/
+namespace draw {
+
+/** Fills a region with a byte pattern, for example, 0xff to fill it
+    or 0x81 to draw a horizontal line at the top and bottom of each
+    page. */
+struct fill {
+    page pg;
+    column col;
+    uint8_t pattern{0xff};
+
+    template<typename Band>
+    void operator()(Band& b) const {
+        if(!b.intersects(pg, col)) return;
+        for(uint8_t p{pg.start}; p <= pg.end; ++p)
+            for(uint8_t c{col.start}; ; ++c) {
+                b.merge(p, c, pattern);
+                if(c == col.end) break;
+            }
+    }
+};
+
+/** Horizontal line from the column 'x0' to 'x1' at the row 'y'. */
+struct hline {
+    uint8_t x0, x1, y;
+
+    template<typename Band>
+    void operator()(Band& b) const {
+        for(uint8_t x{x0}; ; ++x) {
+            b.dot(x, y);
+            if(x == x1) break;
+        }
+    }
+};
+
+/** Vertical line from the row 'y0' to 'y1' at the column 'x'. */
+struct vline {
+    uint8_t x, y0, y1;
+
+    template<typename Band>
+    void operator()(Band& b) const {
+        for(uint8_t y{y0}; y <= y1; ++y) b.dot(x, y);
+    }
+};
+
+/** Border of the rectangle with the corners (x0, y0) and (x1, y1). */
+struct box {
+    uint8_t x0, y0, x1, y1;
+
+    template<typename Band>
+    void operator()(Band& b) const {
+        hline{x0, x1, y0}(b);
+        hline{x0, x1, y1}(b);
+        vline{x0, y0, y1}(b);
+        vline{x1, y0, y1}(b);
+    }
+};
+
+namespace detail {
+
+/** Device that writes the bytes sent to it in a band using the
+    window of the vertical addressing mode. */
+template<typename Band>
+struct band_sink {
+    Band& b;
+    ::ssd1306::detail::window_cursor w;
+
+    void send_byte(uint8_t byte) {
+        b.merge(w.page, w.col, byte);
+        w.advance();
+    }
+};
+
+} //namespace detail
+
+/** Replays a stream of bytes, like the one produced by
+    'send_digit_segmented()' or 'send_int()', at the window given by
+    'pg' and 'col'. 'f' is called with a device that offers
+    send_byte() only when the window intersects the band. */
+template<typename F>
+struct stream_t {
+    page pg;
+    column col;
+    F f;
+
+    template<typename Band>
+    void operator()(Band& b) const {
+        if(!b.intersects(pg, col)) return;
+        detail::band_sink<Band> sink{b, {}};
+        sink.w.pages(pg.start, pg.end);
+        sink.w.columns(col.start, col.end);
+        f(sink);
+    }
+};
+
+template<typename F>
+inline stream_t<F> stream(page pg, column col, F f)
+{ return {pg, col, f}; }
+
+} //namespace draw
+
+/** Renders a region of the screen band by band
+
+    For each band the buffer is cleared, all the draw operations are
+    replayed in the order they were passed and the band is sent to
+    the device using one data transaction. This allows elements to be
+    composed, like digits over a bar graph, using only the RAM of one
+    band.
+
+    Example with 32 bytes of RAM:
+
+      band<1, 32> b;
+      render(i2c, b, page{0, 7}, column{0, 127},
+             draw::box{0, 0, 127, 63},
+             draw::stream(page{2, 5}, column{10, 29}, [](auto& dev){
+                 send_digit_segmented<20, 32>(dev, segments::_7.segments);
+             }));
+*/
+template<typename I2C, uint8_t Pages, uint8_t Columns, typename... Ops>
+void render(I2C&& i2c, band<Pages, Columns>& b,
+            page region_pg, column region_col, const Ops&... ops)
+{
+    for(uint8_t pg{region_pg.start}; pg <= region_pg.end; pg += Pages) {
+        uint8_t npages = region_pg.end - pg + 1;
+        if(npages > Pages) npages = Pages;
+        for(uint8_t col{region_col.start}; ; col += Columns) {
+            uint8_t ncols = region_col.end - col + 1;
+            if(ncols > Columns) ncols = Columns;
+            b.place(pg, col, npages, ncols);
+            (ops(b), ...);
+            b.send(i2c);
+            if(region_col.end - col < Columns) break;
+        }
+        if(region_pg.end - pg < Pages) break;
+    }
+}
+
+/** Renders the whole screen. */
+template<typename I2C, uint8_t Pages, uint8_t Columns, typename... Ops>
+void render(I2C&& i2c, band<Pages, Columns>& b, const Ops&... ops)
+{ render(i2c, b, page{0, 7}, column{0, 127}, ops...); }
+
+}
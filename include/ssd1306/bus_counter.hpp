@@ -0,0 +1,119 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace ssd1306 {
+
+/** Number of bus events produced by an 'i2c'
+
+    scl_pulses are the clocks of the bytes(nine to each byte,
+    including the acknowledge clock) plus the rise of SCL of each stop
+    condition.
+*/
+struct bus_counts {
+    uint32_t starts{0};
+    uint32_t stops{0};
+    uint32_t addr_bytes{0};
+    uint32_t ctrl_bytes{0};
+    uint32_t payload_bytes{0};
+    uint32_t scl_pulses{0};
+
+    uint32_t bytes() const
+    { return addr_bytes + ctrl_bytes + payload_bytes; }
+
+    bus_counts operator-(const bus_counts& o) const {
+        bus_counts r;
+        r.starts = starts - o.starts;
+        r.stops = stops - o.stops;
+        r.addr_bytes = addr_bytes - o.addr_bytes;
+        r.ctrl_bytes = ctrl_bytes - o.ctrl_bytes;
+        r.payload_bytes = payload_bytes - o.payload_bytes;
+        r.scl_pulses = scl_pulses - o.scl_pulses;
+        return r;
+    }
+};
+
+/** Counting policy that doesn't count anything
+
+    This is the default policy of 'i2c', all the hooks are empty and
+    they are compiled to nothing.
+*/
+struct no_counter {
+    static void start() {}
+    static void addr_byte() {}
+    static void ctrl_byte() {}
+    static void payload_byte() {}
+    static void stop() {}
+};
+
+/** Counting policy that keeps cumulative and per transaction counts
+
+    'total' has all the events since the beginning of the program or
+    since the last call to reset(). 'transaction' has the events of
+    the current transaction, or of the last one if there isn't an open
+    transaction, it's cleared by each start condition.
+
+    The counts are static, so the buses that should be measured
+    separately must use distinct tags.
+
+    Example:
+
+      display<pb0_t, pb2_t, sa0::off_t, bus_counter<>> disp{pb0, pb2};
+
+      auto before = bus_counter<>::total;
+      disp.out(page{0, 0}, column{0, 7}, bytes);
+      auto cost = bus_counter<>::total - before;
+*/
+template<typename Tag = void>
+struct bus_counter {
+    static bus_counts total;
+    static bus_counts transaction;
+
+    static void reset() {
+        total = bus_counts{};
+        transaction = bus_counts{};
+    }
+
+    static void start() {
+        transaction = bus_counts{};
+        ++transaction.starts;
+        ++total.starts;
+    }
+
+    static void addr_byte() {
+        ++transaction.addr_bytes;
+        ++total.addr_bytes;
+        pulses(9);
+    }
+
+    static void ctrl_byte() {
+        ++transaction.ctrl_bytes;
+        ++total.ctrl_bytes;
+        pulses(9);
+    }
+
+    static void payload_byte() {
+        ++transaction.payload_bytes;
+        ++total.payload_bytes;
+        pulses(9);
+    }
+
+    static void stop() {
+        ++transaction.stops;
+        ++total.stops;
+        pulses(1);
+    }
+private:
+    static void pulses(uint8_t n) {
+        transaction.scl_pulses += n;
+        total.scl_pulses += n;
+    }
+};
+
+template<typename Tag>
+bus_counts bus_counter<Tag>::total;
+
+template<typename Tag>
+bus_counts bus_counter<Tag>::transaction;
+
+}
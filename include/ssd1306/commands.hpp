@@ -4,22 +4,293 @@
 
 namespace ssd1306 {
 
+/** Commands
+
+    Each command is a type and its arguments are template parameters,
+    so the ranges are checked at compile time. The commands follow the
+    section '10 Command Descriptions' of the datasheet. All of them
+    have the members:
+
+    bytes: the command followed by its arguments.
+    size: number of bytes.
+    kind: commands of the same kind change the same setting, so only
+          the last one of a sequence has effect. The value 0 means
+          that the command doesn't replace another one.
+    is_reset_default: true if the command sets the value that the
+                      setting has after the reset.
+
+    A sequence of commands can be merged at compile time, take a look
+    at 'ssd1306/detail/merge_cmds.hpp'.
+*/
+namespace detail {
+
+template<uint8_t Kind, bool Default, uint8_t... Bytes>
+struct command {
+    constexpr static uint8_t bytes[sizeof...(Bytes)]{Bytes...};
+    constexpr static int size{sizeof...(Bytes)};
+    constexpr static uint8_t kind{Kind};
+    constexpr static bool is_reset_default{Default};
+};
+
+template<uint8_t Kind, bool Default, uint8_t... Bytes>
+constexpr uint8_t command<Kind, Default, Bytes...>::bytes[];
+
+} //namespace detail
+
+/** Forces a command to be sent even when it's equal to the reset
+    value or when another command of the same kind is after it. */
+template<typename Cmd>
+struct always : Cmd {
+    constexpr static uint8_t kind{0};
+    constexpr static bool is_reset_default{false};
+};
+
+/**
+ * Fundamental commands
+ */
+
+/** Contrast level from 1 to 256 in steps of 'level + 1'. */
 template<uint8_t plevel>
-struct contrast{
+struct contrast : detail::command<0x81, plevel == 0x7f, 0x81, plevel> {
     constexpr static uint8_t level{plevel};
-    constexpr static int size{2};
 };
 
 enum class turn{ on, off };
 
-struct turn_on{
+struct turn_on : detail::command<0xae, false, 0xaf> {
     constexpr static uint8_t code{0xaf};
-    constexpr static int size{1};
 };
 
-struct turn_off{
+struct turn_off : detail::command<0xae, true, 0xae> {
     constexpr static uint8_t code{0xae};
-    constexpr static int size{1};
 };
 
+/** All dots on(true) ignoring the GDDRAM or the output following the
+    GDDRAM content(false). */
+template<bool on>
+struct entire_display_on
+    : detail::command<0xa4, !on, on ? 0xa5 : 0xa4> {};
+
+/** Inverse(true) or normal(false) display. */
+template<bool on>
+struct inverse_display
+    : detail::command<0xa6, !on, on ? 0xa7 : 0xa6> {};
+
+/**
+ * Addressing setting commands
+ */
+
+enum class addressing : uint8_t { horizontal = 0, vertical = 1, page = 2 };
+
+template<addressing mode>
+struct addressing_mode
+    : detail::command<0x20, mode == addressing::page, 0x20, uint8_t(mode)>
+{};
+
+/** Column window used by the horizontal and vertical addressing
+    modes. */
+template<uint8_t start, uint8_t end>
+struct column_address
+    : detail::command<0x21, start == 0 && end == 127, 0x21, start, end>
+{
+    static_assert(start <= 127 && end <= 127, "column must be in [0, 127]");
+};
+
+/** Page window used by the horizontal and vertical addressing
+    modes. */
+template<uint8_t start, uint8_t end>
+struct page_address
+    : detail::command<0x22, start == 0 && end == 7, 0x22, start, end>
+{
+    static_assert(start <= 7 && end <= 7, "page must be in [0, 7]");
+};
+
+/** Page of the address pointer in the page addressing mode. */
+template<uint8_t pg>
+struct page_start : detail::command<0xb0, pg == 0, 0xb0 | pg> {
+    static_assert(pg <= 7, "page must be in [0, 7]");
+};
+
+/** Column of the address pointer in the page addressing mode. */
+template<uint8_t col>
+struct column_start
+    : detail::command<0x10, col == 0, col & 0x0f, 0x10 | (col >> 4)>
+{
+    static_assert(col <= 127, "column must be in [0, 127]");
+};
+
+/**
+ * Hardware configuration commands
+ */
+
+/** Row of the GDDRAM that is shown at the top of the display. */
+template<uint8_t line>
+struct start_line : detail::command<0x40, line == 0, 0x40 | line> {
+    static_assert(line <= 63, "start line must be in [0, 63]");
+};
+
+/** The column 127 is mapped to SEG0(true) or the column 0 is mapped
+    to SEG0(false). */
+template<bool remapped>
+struct segment_remap
+    : detail::command<0xa0, !remapped, remapped ? 0xa1 : 0xa0> {};
+
+/** Number of COM lines that are used, from 16 to 64. */
+template<uint8_t ratio>
+struct multiplex_ratio
+    : detail::command<0xa8, ratio == 64, 0xa8, uint8_t(ratio - 1)>
+{
+    static_assert(ratio >= 16 && ratio <= 64,
+                  "multiplex ratio must be in [16, 64]");
+};
+
+/** Scan from COM[N-1] to COM0(true) or from COM0 to
+    COM[N-1](false). */
+template<bool remapped>
+struct com_scan
+    : detail::command<0xc0, !remapped, remapped ? 0xc8 : 0xc0> {};
+
+/** Vertical shift by COM from 0 to 63. */
+template<uint8_t offset>
+struct display_offset : detail::command<0xd3, offset == 0, 0xd3, offset> {
+    static_assert(offset <= 63, "offset must be in [0, 63]");
+};
+
+/** Hardware configuration of the COM pins: alternative(true) or
+    sequential(false) and with(true) or without(false) the left/right
+    remap. */
+template<bool alternative, bool left_right_remap = false>
+struct com_pins
+    : detail::command<0xda, alternative && !left_right_remap, 0xda,
+                      uint8_t(0x02 | (alternative << 4)
+                              | (left_right_remap << 5))>
+{};
+
+/**
+ * Timing and driving scheme setting commands
+ */
+
+/** Divide ratio of the display clock from 1 to 16 and the oscillator
+    frequency from 0 to 15. */
+template<uint8_t divide, uint8_t frequency = 8>
+struct clock_divide
+    : detail::command<0xd5, divide == 1 && frequency == 8, 0xd5,
+                      uint8_t((frequency << 4) | (divide - 1))>
+{
+    static_assert(divide >= 1 && divide <= 16,
+                  "divide ratio must be in [1, 16]");
+    static_assert(frequency <= 15, "frequency must be in [0, 15]");
+};
+
+/** Pre-charge period of the phases 1 and 2, from 1 to 15 DCLKs. */
+template<uint8_t phase1, uint8_t phase2>
+struct precharge
+    : detail::command<0xd9, phase1 == 2 && phase2 == 2, 0xd9,
+                      uint8_t((phase2 << 4) | phase1)>
+{
+    static_assert(phase1 >= 1 && phase1 <= 15, "phase 1 must be in [1, 15]");
+    static_assert(phase2 >= 1 && phase2 <= 15, "phase 2 must be in [1, 15]");
+};
+
+enum class vcomh_level : uint8_t {
+    vcc_065 = 0x00, // ~0.65 x VCC
+    vcc_077 = 0x20, // ~0.77 x VCC
+    vcc_083 = 0x30, // ~0.83 x VCC
+};
+
+/** VCOMH deselect level. */
+template<vcomh_level level>
+struct vcomh
+    : detail::command<0xdb, level == vcomh_level::vcc_077, 0xdb,
+                      uint8_t(level)>
+{};
+
+struct nop : detail::command<0x00, false, 0xe3> {};
+
+/** Internal charge pump regulator enabled(true) or disabled(false).
+    It should be enabled before turning on the display when the panel
+    doesn't have an external VCC. */
+template<bool on>
+struct charge_pump
+    : detail::command<0x8d, !on, 0x8d, on ? 0x14 : 0x10> {};
+
+/**
+ * Scrolling commands
+ */
+
+enum class scroll_dir { right, left };
+
+namespace detail {
+
+constexpr uint8_t scroll_interval(uint16_t frames) {
+    return frames == 5 ? 0 : frames == 64 ? 1 : frames == 128 ? 2
+        : frames == 256 ? 3 : frames == 3 ? 4 : frames == 4 ? 5
+        : frames == 25 ? 6 : frames == 2 ? 7 : 0xff;
+}
+
+} //namespace detail
+
+/** Continuous horizontal scroll of the pages [start_page, end_page]
+    with a step each 'frames' frames. The valid intervals are 2, 3,
+    4, 5, 25, 64, 128 and 256 frames. */
+template<scroll_dir dir, uint8_t start_page, uint8_t end_page,
+         uint16_t frames = 5>
+struct horizontal_scroll
+    : detail::command<0x00, false,
+                      dir == scroll_dir::right ? 0x26 : 0x27,
+                      0x00, start_page,
+                      detail::scroll_interval(frames),
+                      end_page, 0x00, 0xff>
+{
+    constexpr static bool is_scroll_setup{true};
+    constexpr static uint8_t offset{0};
+
+    static_assert(start_page <= 7 && end_page <= 7,
+                  "page must be in [0, 7]");
+    static_assert(start_page <= end_page,
+                  "start page must not be greater than end page");
+    static_assert(detail::scroll_interval(frames) != 0xff,
+                  "interval must be 2, 3, 4, 5, 25, 64, 128 or 256 frames");
+};
+
+/** Continuous vertical and horizontal scroll. Each step moves the
+    rows of the vertical scroll area 'vertical_offset' rows up. */
+template<scroll_dir dir, uint8_t start_page, uint8_t end_page,
+         uint8_t vertical_offset, uint16_t frames = 5>
+struct diagonal_scroll
+    : detail::command<0x00, false,
+                      dir == scroll_dir::right ? 0x29 : 0x2a,
+                      0x00, start_page,
+                      detail::scroll_interval(frames),
+                      end_page, vertical_offset>
+{
+    constexpr static bool is_scroll_setup{true};
+    constexpr static uint8_t offset{vertical_offset};
+
+    static_assert(start_page <= 7 && end_page <= 7,
+                  "page must be in [0, 7]");
+    static_assert(start_page <= end_page,
+                  "start page must not be greater than end page");
+    static_assert(vertical_offset >= 1 && vertical_offset <= 63,
+                  "vertical offset must be in [1, 63]");
+    static_assert(detail::scroll_interval(frames) != 0xff,
+                  "interval must be 2, 3, 4, 5, 25, 64, 128 or 256 frames");
+};
+
+/** Rows [top, top + rows) that are scrolled vertically. */
+template<uint8_t ptop, uint8_t prows>
+struct vertical_scroll_area
+    : detail::command<0xa3, ptop == 0 && prows == 64, 0xa3, ptop, prows>
+{
+    static_assert(ptop <= 63, "top must be in [0, 63]");
+    static_assert(prows <= 64 && ptop + prows <= 64,
+                  "the area must be inside of the 64 rows");
+    constexpr static uint8_t top{ptop};
+    constexpr static uint8_t rows{prows};
+};
+
+struct activate_scroll : detail::command<0x2e, false, 0x2f> {};
+
+struct deactivate_scroll : detail::command<0x2e, true, 0x2e> {};
+
 }
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "ssd1306/font5x7.hpp"
+#include "ssd1306/set_page_column.hpp"
+
+#include <stdint.h>
+
+namespace ssd1306 {
+
+/** Text console with eight lines that scrolls using the start line
+
+    The GDDRAM is a circular buffer of pages. The line at the top of
+    the screen is the page 'top' and the line 'i' is the page
+    '(top + i) % 8'. When the cursor is at the last line, a new line
+    writes its text on the page of the top line, which leaves the
+    screen, and the start line command(0x40 | row) moves that page to
+    the bottom. A scroll costs one command byte plus the bytes of the
+    new line, the other lines aren't sent again.
+
+    Each page remembers how many columns have text, so a line that is
+    reused is cleared only up to the end of its old text, in the same
+    transaction of the new one. The top line shows the new text while
+    it's being sent, just before the scroll.
+
+    The new line of '\n' is deferred until the next character, so the
+    last line is kept at the bottom instead of an empty one. A line
+    that is full is wrapped in the same way.
+
+    Font: glyphs of one page with the interface of 'font5x7'.
+
+    precondition: the device is using the vertical addressing mode,
+    the screen is clear and the start line is 0, which is the state
+    after the constructor of 'display'. clear() restores it.
+
+    Example:
+
+      console<> con;
+      con.print(disp.device(), "boot\n");
+      con.print(disp.device(), "ready\n");
+*/
+template<typename Font = font5x7>
+class console {
+    static constexpr uint8_t columns{128 / Font::advance};
+    uint8_t _top{0}, _line{0}, _col{0};
+    bool _newline{false};
+    uint8_t _len[8]{};
+
+    uint8_t page_of(uint8_t line) const { return (_top + line) & 7; }
+
+    template<typename I2C>
+    void send_start_line(I2C&& i2c) {
+        i2c.start_commands();
+        i2c.send_byte(0x40 | (_top << 3));
+        i2c.stop_condition();
+    }
+public:
+    static constexpr uint8_t lines{8};
+
+    /** Number of characters of a line. */
+    static constexpr uint8_t width() { return columns; }
+
+    uint8_t cursor_line() const { return _line; }
+    uint8_t cursor_column() const { return _col; }
+
+    /** Clears the screen and returns the start line to 0. */
+    template<typename I2C>
+    void clear(I2C&& i2c) {
+        _top = _line = _col = 0;
+        _newline = false;
+        for(auto& l : _len) l = 0;
+        send_start_line(i2c);
+        set(i2c, page{0, 7}, column{0, 127});
+        i2c.start_data();
+        for(uint16_t i{0}; i < 128 * 8; ++i) i2c.send_byte(0x00);
+        i2c.stop_condition();
+    }
+
+    /** Prints a string. Each run of characters of a line is sent
+        using one window and one data transaction. */
+    template<typename I2C>
+    void print(I2C&& i2c, const char* s) {
+        while(*s) {
+            bool scroll{false};
+            if(_newline) {
+                _newline = false;
+                _col = 0;
+                if(_line < lines - 1) ++_line;
+                else scroll = true;
+            }
+            //the new bottom line uses the page of the top line
+            uint8_t pg = scroll ? _top : page_of(_line);
+            uint8_t n{0};
+            while(s[n] && s[n] != '\n' && _col + n < columns) ++n;
+            uint8_t col0 = _col * Font::advance;
+            uint8_t end = (_col + n) * Font::advance;
+            if(n || end < _len[pg]) {
+                set(i2c, page{pg, pg}, column{col0, 127});
+                i2c.start_data();
+                for(; n; --n, ++s, ++_col) Font::send(i2c, *s);
+                for(uint8_t c{end}; c < _len[pg]; ++c) i2c.send_byte(0x00);
+                i2c.stop_condition();
+                _len[pg] = end;
+            }
+            if(scroll) {
+                _top = (_top + 1) & 7;
+                send_start_line(i2c);
+            }
+            if(*s == '\n') {
+                ++s;
+                _newline = true;
+            } else if(_col == columns) _newline = true;
+        }
+    }
+
+    template<typename I2C>
+    void put(I2C&& i2c, char c) {
+        const char s[] = {c, '\0'};
+        print(i2c, s);
+    }
+};
+
+}
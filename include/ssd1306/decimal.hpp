@@ -0,0 +1,103 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace ssd1306 {
+
+/** Value passed instead of a digit to the positions that are padded
+    with blanks by 'for_each_digit()'. */
+constexpr uint8_t digit_blank{0xff};
+
+namespace detail {
+
+constexpr uint8_t digits_of(uint32_t p)
+{ return p < 10 ? 1 : 1 + digits_of(p / 10); }
+
+/** Emits the digit of the position with weight P and the ones to
+    its right. Each digit is obtained subtracting P, so there isn't
+    any division. */
+template<typename UInt, uint32_t P>
+struct decimal_digits {
+    template<typename F>
+    static void emit(UInt n, F& f, uint8_t width, uint8_t pad,
+                     bool started, uint8_t& count)
+    {
+        uint8_t d{0};
+        while(n >= P) {
+            n -= P;
+            ++d;
+        }
+        if(d || started) {
+            started = true;
+            f(d);
+            ++count;
+        } else if(width >= digits_of(P)) {
+            f(pad);
+            ++count;
+        }
+        decimal_digits<UInt, P / 10>::emit
+            (n, f, width, pad, started, count);
+    }
+};
+
+template<typename UInt>
+struct decimal_digits<UInt, 1> {
+    template<typename F>
+    static void emit(UInt n, F& f, uint8_t, uint8_t, bool, uint8_t& count) {
+        f(uint8_t(n));
+        ++count;
+    }
+};
+
+template<typename UInt, uint32_t P, typename F>
+inline uint8_t emit_digits(UInt n, F& f, uint8_t width, uint8_t pad) {
+    uint8_t count{0};
+    for(; width > digits_of(P); --width) {
+        f(pad);
+        ++count;
+    }
+    decimal_digits<UInt, P>::emit(n, f, width, pad, false, count);
+    return count;
+}
+
+} //namespace detail
+
+/** Calls 'f' with each decimal digit of 'n' from the most
+    significant to the least significant one
+
+    The conversion doesn't use division, which is a call to a long
+    routine on AVR. Each digit is obtained by successive subtractions
+    of its weight, there are at most nine subtractions to each
+    position and the weights are immediate values. There is one
+    function to 8, 16 and 32 bits, so each type uses only the
+    positions that it can have.
+
+    width: minimum number of positions. The positions at the left of
+           the most significant digit are emitted as 'pad', so the
+           number is right aligned. The default value 0 doesn't pad.
+    pad: value passed to 'f' to each padding position. It's
+         'digit_blank' by default and it can be 0 to pad with zeros.
+
+    Returns the number of calls to 'f'.
+
+    Example:
+
+      for_each_digit(uint16_t{42}, [](uint8_t d){ ... }, 4);
+      //f(digit_blank), f(digit_blank), f(4), f(2)
+*/
+template<typename F>
+inline uint8_t for_each_digit(uint8_t n, F&& f, uint8_t width = 0,
+                              uint8_t pad = digit_blank)
+{ return detail::emit_digits<uint8_t, 100>(n, f, width, pad); }
+
+template<typename F>
+inline uint8_t for_each_digit(uint16_t n, F&& f, uint8_t width = 0,
+                              uint8_t pad = digit_blank)
+{ return detail::emit_digits<uint16_t, 10000>(n, f, width, pad); }
+
+template<typename F>
+inline uint8_t for_each_digit(uint32_t n, F&& f, uint8_t width = 0,
+                              uint8_t pad = digit_blank)
+{ return detail::emit_digits<uint32_t, 1000000000>(n, f, width, pad); }
+
+}
@@ -1,55 +1,89 @@
 #pragma once
 
 #include "ssd1306/commands.hpp"
-#include "ssd1306/send_commands.hpp"
+#include "ssd1306/detail/progmem.hpp"
 
 #include <stdint.h>
 
 namespace ssd1306 { namespace detail {
 
-template<typename Cmd>
-constexpr int size_to(Cmd){ return Cmd::size; }
-constexpr int size_to(turn){ return 1; }
+template<int N>
+struct Data{
+    uint8_t data[N];
+};
 
-template<int N, uint8_t level>
-constexpr void handle(uint8_t (&a)[N], int& i, contrast<level> o) {
-    a[i++] = 0x81;
-    a[i++] = o.level;
+/** True if the command at the position 'i' of a sequence should be
+    sent. All commands are sent if 'from_reset' is false, otherwise
+    the command isn't equal to the reset value and there isn't another
+    command of the same kind after it. */
+template<int N>
+constexpr bool keep(const uint8_t (&kinds)[N], const bool (&defaults)[N],
+                    int i, bool from_reset)
+{
+    if(!from_reset) return true;
+    if(defaults[i]) return false;
+    if(kinds[i] == 0) return true;
+    for(int j{i + 1}; j < N; ++j)
+        if(kinds[j] == kinds[i]) return false;
+    return true;
 }
 
-template<int N, typename Cmd>
-constexpr void handle(uint8_t (&a)[N], int& i, Cmd) {
-    a[i++] = Cmd::code;
+template<bool FromReset, typename... Cmds>
+constexpr int merged_size() {
+    constexpr int n = sizeof...(Cmds);
+    constexpr uint8_t kinds[n + 1] = {Cmds::kind..., 0};
+    constexpr bool defaults[n + 1] = {Cmds::is_reset_default..., true};
+    constexpr int sizes[n + 1] = {Cmds::size..., 0};
+    int size{0};
+    for(int i{}; i < n; ++i)
+        if(keep(kinds, defaults, i, FromReset)) size += sizes[i];
+    return size;
 }
 
-template<int N, typename Cmd>
-inline constexpr void handle(uint8_t (&a)[N], int& i, turn o) {
-    if(o == turn::on) a[i++] = 0xaf;
-    else a[i++] = 0xae;
+template<typename Cmd, int N>
+constexpr void append(uint8_t (&a)[N], int& pos, bool keep) {
+    if(!keep) return;
+    for(int i{}; i < Cmd::size; ++i)
+        a[pos++] = Cmd::bytes[i];
 }
 
-template<int N>
-struct Data{
-    uint8_t data[N];
-};
+/** Merges a sequence of commands to one array of bytes
 
-template<typename I2C, int N>
-constexpr auto merge_cmds(I2C&& i2c, const uint8_t (&o)[N]) {
-    Data<N> ret;
-    for(int i{}; i < N; ++i)
-        ret.data[i] = o[i];
-    return ret;
-}
-    
-template<typename I2C, int N, typename... Cmds>
-constexpr auto merge_cmds(I2C&& i2c, const uint8_t (&o)[N], Cmds... cmds) {
-    constexpr auto size = N + (size_to(cmds) + ...);
-    Data<size> ret;
-    int i{};
-    for(; i < N; ++i)
-        ret.data[i] = o[i];
-    (handle(ret.data, i, cmds), ...);
+    FromReset: if true, the commands that repeat the reset value of a
+               setting or that are replaced by a later command of the
+               same kind are dropped. Take a look at
+               'ssd1306/commands.hpp'. If false, all commands are
+               kept.
+
+    precondition: if 'FromReset' is true, the controller is in the
+    reset state when the sequence is sent, which is true after the
+    power on. Use 'always<Cmd>' to send a command regardless of this
+    assumption.
+*/
+template<bool FromReset, typename... Cmds>
+constexpr auto merge_cmds() {
+    constexpr int n = sizeof...(Cmds);
+    constexpr uint8_t kinds[n + 1] = {Cmds::kind..., 0};
+    constexpr bool defaults[n + 1] = {Cmds::is_reset_default..., true};
+    Data<merged_size<FromReset, Cmds...>() + 1> ret{};
+    int pos{0}, i{0};
+    (append<Cmds>(ret.data, pos, keep(kinds, defaults, i++, FromReset)),
+     ...);
+    (void)kinds, (void)defaults, (void)pos;
     return ret;
 }
 
+/** Merged sequence stored in the flash. 'size' can be zero, the last
+    byte of 'value' isn't part of the sequence. */
+template<bool FromReset, typename... Cmds>
+struct merged_commands {
+    constexpr static int size{merged_size<FromReset, Cmds...>()};
+    static const Data<size + 1> value;
+};
+
+template<bool FromReset, typename... Cmds>
+const Data<merged_commands<FromReset, Cmds...>::size + 1>
+merged_commands<FromReset, Cmds...>::value SSD1306_PROGMEM =
+    merge_cmds<FromReset, Cmds...>();
+
 }}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#endif
+
+//Places a constant in the program memory(flash) on AVR. On the host,
+//like the simulation, the constant is a regular one.
+#ifdef __AVR__
+#define SSD1306_PROGMEM PROGMEM
+#else
+#define SSD1306_PROGMEM
+#endif
+
+namespace ssd1306 { namespace detail {
+
+//Reads a byte of a constant defined with SSD1306_PROGMEM.
+inline uint8_t read_flash(const uint8_t* p) {
+#ifdef __AVR__
+    return pgm_read_byte(p);
+#else
+    return *p;
+#endif
+}
+
+}}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace ssd1306 { namespace detail {
+
+/** Page/column window with an address pointer that is incremented
+    like the one of the controller using the vertical addressing
+    mode. */
+struct window_cursor {
+    uint8_t page_start{0}, page_end{7};
+    uint8_t col_start{0}, col_end{127};
+    uint8_t page{0}, col{0};
+
+    void pages(uint8_t start, uint8_t end) {
+        page_start = start & 0x07;
+        page_end = end & 0x07;
+        page = page_start;
+    }
+
+    void columns(uint8_t start, uint8_t end) {
+        col_start = start & 0x7f;
+        col_end = end & 0x7f;
+        col = col_start;
+    }
+
+    void advance() {
+        if(page == page_end) {
+            page = page_start;
+            col = col == col_end ? col_start : col + 1;
+        } else ++page;
+    }
+};
+
+/** Parser of the commands 0x21(column address) and 0x22(page
+    address) that updates a 'window_cursor'. Any other command is
+    ignored. */
+class window_commands {
+    uint8_t _cmd{0}, _nargs{0}, _arg{0};
+public:
+    void reset() { _nargs = 0; }
+
+    void operator()(window_cursor& w, uint8_t byte) {
+        if(_nargs == 0) {
+            if(byte == 0x21 || byte == 0x22) {
+                _cmd = byte;
+                _nargs = 2;
+            }
+        } else if(_nargs == 2) {
+            _arg = byte;
+            _nargs = 1;
+        } else {
+            if(_cmd == 0x21) w.columns(_arg, byte);
+            else w.pages(_arg, byte);
+            _nargs = 0;
+        }
+    }
+};
+
+}}
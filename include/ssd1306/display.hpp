@@ -2,10 +2,15 @@
 
 #include "ssd1306/commands.hpp"
 #include "ssd1306/detail/merge_cmds.hpp"
+#include "ssd1306/detail/progmem.hpp"
+#include "ssd1306/font.hpp"
+#include "ssd1306/framebuffer.hpp"
 #include "ssd1306/i2c.hpp"
+#include "ssd1306/packbits.hpp"
 #include "ssd1306/send_commands.hpp"
 #include "ssd1306/send_seven_segment.hpp"
 #include "ssd1306/set_page_column.hpp"
+#include "ssd1306/window_cache.hpp"
 
 #include <stdint.h>
 
@@ -14,30 +19,119 @@ namespace ssd1306 {
 template<typename T>
 struct repeat{ T value; };
 
-template<typename Sda, typename Scl>
-class display {
-    template<uint8_t w, uint8_t h>
-    void out_impl(seven_segment seg)
-    { send_digit_segmented<w,h>(_i2c, seg.segments); }
-
-    template<uint8_t w, uint8_t h>
-    void out_impl(uint8_t v)
-    { send_int<w, h>(_i2c, v); }
-
-    template<uint8_t w, uint8_t h>
-    uint8_t out_impl(uint32_t n) {
-        auto whole = n / 100;
-        auto decimal = n % 100;
-
-        auto d = decimal / 10;
-        auto r = decimal % 10;
-        if(r >= 5) {
-            if(d == 9) {
-                ++whole;
-                d = 0;
-            } else ++d;
-        }
-        auto n_digits = send_int<w, h>(_i2c, whole);
+/** Span of bytes in the program memory
+
+    The bytes are defined with SSD1306_PROGMEM and they are streamed
+    from the flash to the bus by the out() overloads of the display,
+    without a copy in RAM. The size has 16 bits, so a whole screen(1024
+    bytes) is one span.
+
+    Example:
+
+      static const uint8_t splash[1024] SSD1306_PROGMEM = {...};
+      disp.out(page{0, 7}, column{0, 127}, flash(splash));
+*/
+struct flash_bytes {
+    const uint8_t* bytes;
+    uint16_t size;
+};
+
+template<uint16_t N>
+constexpr flash_bytes flash(const uint8_t (&bytes)[N])
+{ return {bytes, N}; }
+
+namespace detail {
+
+/** Sends the initialization commands followed by the user ones
+
+    The window commands are always sent because the constructor clears
+    the whole screen using them, even if the MCU was reset without a
+    power cycle of the display.
+*/
+template<typename I2C, typename... Cmds>
+inline void send_init(Cmds... cmds) {
+    send_commands_from_reset(I2C{},
+                             com_scan<true>{},
+                             segment_remap<true>{},
+                             addressing_mode<addressing::vertical>{},
+                             always<page_address<0, 7>>{},
+                             always<column_address<0, 127>>{},
+                             charge_pump<true>{},
+                             cmds...);
+}
+
+/** True if one of the commands changes the addressing mode, the
+    windows or the pointer. */
+template<typename... Cmds>
+constexpr bool changes_window() {
+    uint8_t codes[] = {Cmds::bytes[0]..., 0xe3};
+    for(uint8_t i{0}; i < sizeof...(Cmds); ++i) {
+        auto c = codes[i];
+        if(c <= 0x22 || (c & 0xf8) == 0xb0) return true;
+    }
+    (void)codes;
+    return false;
+}
+
+/** Bus of a device. The writes to a 'framebuffer' don't reach the
+    GDDRAM, only its flush() does. */
+template<typename Dev>
+struct bus_of {
+    using type = Dev;
+    static constexpr bool buffered{false};
+};
+
+template<typename I2C>
+struct bus_of<framebuffer<I2C>> {
+    using type = I2C;
+    static constexpr bool buffered{true};
+};
+
+template<typename T, typename = void>
+struct is_scroll_setup { static constexpr bool value{false}; };
+
+template<typename T>
+struct is_scroll_setup<T, decltype(void(T::is_scroll_setup))>
+{ static constexpr bool value{T::is_scroll_setup}; };
+
+} //namespace detail
+
+/** Output operations of a display
+
+    Dev: device that receives the bytes. It can be the bus itself, like
+         'i2c', or a 'framebuffer'.
+    Window: policy that sets the window of the output operations that
+            receive a page or a column. Take a look at
+            'ssd1306/window_cache.hpp'.
+*/
+template<typename Dev, typename Window = no_window_cache>
+class basic_display {
+    template<uint8_t w, uint8_t h, typename D>
+    static void out_impl(D& dev, seven_segment seg)
+    { send_digit_segmented<w,h>(dev, seg.segments); }
+
+    template<uint8_t w, uint8_t h, typename D>
+    static void out_impl(D& dev, uint8_t v)
+    { send_int<w, h>(dev, v); }
+
+    /** Sends 'n / 100' rounded to one decimal place.
+
+        The digits of 'n + 5' without the last one are the digits of
+        the rounded value, they are sent with a delay of two digits to
+        put the dot before the decimal place. The rounding is skipped
+        when 'n + 5' overflows.
+     */
+    template<uint8_t w, uint8_t h, typename D>
+    static uint8_t out_impl(D& dev, uint32_t n) {
+        if(n <= 0xfffffffa) n += 5;
+        uint8_t prev[2]{};
+        uint8_t n_digits{0};
+        for_each_digit(n, [&](uint8_t d){
+            if(n_digits >= 2) send_digit<w, h, 5>(dev, prev[0]);
+            prev[0] = prev[1];
+            prev[1] = d;
+            ++n_digits;
+        }, 3, 0);
         static const uint8_t dot[] = {
             0x00, 0x00, 0x00, 0xf0,
             0x00, 0x00, 0x00, 0xf0,
@@ -49,133 +143,365 @@ class display {
             0x00, 0x00, 0x00, 0x00,
             };
         for(uint8_t i{}; i < sizeof(dot); ++i)
-            _i2c.send_byte(dot[i]);
-        
-        return n_digits + send_int<w, h>(_i2c, d);
+            dev.send_byte(dot[i]);
+        send_digit<w, h, 5>(dev, prev[0]);
+        return n_digits - 1;
     }
     
-    template<uint8_t w, uint8_t h, int N>
-    void out_impl(const uint8_t (&bytes)[N]) {
-        for(uint8_t i{}; i < N; ++i)
-            _i2c.send_byte(bytes[i]);
+    template<uint8_t w, uint8_t h, typename D, int N>
+    static void out_impl(D& dev, const uint8_t (&bytes)[N]) {
+        for(uint16_t i{}; i < N; ++i)
+            dev.send_byte(bytes[i]);
     }
+
+    /** The pointer is incremented instead of indexed, which allows
+        the post-increment load from the flash(LPM Z+) on the AVR. */
+    template<typename D>
+    static void out_impl(D& dev, flash_bytes src) {
+        const uint8_t* end = src.bytes + src.size;
+        for(const uint8_t* p{src.bytes}; p != end; ++p)
+            dev.send_byte(detail::read_flash(p));
+    }
+
+    template<typename D, typename T>
+    static void out_impl(D& dev, uint8_t byte, const repeat<T>& rep) {
+        for(T i{}; i < rep.value; ++i)
+            dev.send_byte(byte);
+    }
+
+    /** The literal runs are sent like 'flash_bytes' and the repeated
+        runs like 'repeat'. */
+    template<typename D>
+    static void out_impl(D& dev, packed_bytes src) {
+        for_each_packet(src,
+            [&](const uint8_t* p, uint8_t n)
+            { out_impl(dev, flash_bytes{p, n}); },
+            [&](uint8_t byte, uint8_t n)
+            { out_impl(dev, byte, repeat<uint8_t>{n}); });
+    }
+
+    /** Data transaction to the device with 'len' bytes, or 0 if the
+        length isn't known. The scroll is stopped before because the
+        GDDRAM can't be written while it's active. */
+    template<typename F>
+    void write(F&& f, uint16_t len = 0) {
+        if(!detail::bus_of<Dev>::buffered && _scrolling) stop_scroll();
+        _window.write(_dev, f, len);
+    }
+protected:
+    using bus_t = typename detail::bus_of<Dev>::type;
+
+    Dev _dev;
+    Window _window;
+    bool _scrolling{false};
 public:
-    using i2c_t = ::ssd1306::i2c<Sda, Scl>;
-private:
-    i2c_t _i2c;
-public:
-    display() = default;
-    
-    template<typename... Cmds>
-    display(Sda sda, Scl scl, Cmds... cmds)
-        : _i2c(sda, scl)
-    {
-        constexpr static uint8_t data[] = {
-            0xC8, /** COM Output Scan Direction*/ 
-            0xA1, /** Segment Re-map */
+    using device_t = Dev;
+    using window_t = Window;
 
-            0x20, 1, /** Vertical Addressing Mode*/ 
-            0x22, 0, 7, /** Set page address: 0 to 7*/  
-            0x21, 0, 127, /** Set column address: 0 to 127*/
-    
-            0x8D, 0x14, /** Enable Charge Pump*/
-        };
-        
-        constexpr static auto data2 = detail::merge_cmds(i2c_t{}, data, cmds...);
-        send_commands(_i2c, data2.data);
-        
-        /** clear the whole screen */
-        out(0x00, repeat<uint16_t>{128 * 8});
+    basic_display() = default;
+
+    explicit basic_display(const Dev& dev) : _dev(dev) {}
+
+    /** Device used by the output operations
+
+        The window policy forgets the state of the controller because
+        the device can be used to change it. 'window_cache' sends to
+        the bus the commands that it kept to the next write and, if
+        it's using the page addressing mode, the commands to switch
+        back to the vertical addressing mode. So this call can send
+        bytes, the const overload doesn't.
+    */
+    Dev& device() {
+        _window.release(_dev);
+        return _dev;
+    }
+
+    const Dev& device() const { return _dev; }
+
+    /** Starts a continuous scroll
+
+        'setup' is 'horizontal_scroll' or 'diagonal_scroll' and 'area'
+        is an optional 'vertical_scroll_area', all of them from
+        'ssd1306/commands.hpp', so the pages and the interval are
+        checked at compile time. The scroll is deactivated before the
+        setup, as required by the datasheet, and everything is sent in
+        one transaction.
+
+        The controller scrolls the pages without any transfer of the
+        GDDRAM. The output operations stop the scroll before writing
+        to the GDDRAM, the content that was scrolled should be
+        rewritten after that.
+
+        Example:
+
+          disp.scroll(horizontal_scroll<scroll_dir::left, 6, 7, 2>{});
+    */
+    template<typename Setup, typename... Area>
+    void scroll(Setup setup, Area...) {
+        static_assert(detail::is_scroll_setup<Setup>::value,
+                      "setup must be horizontal_scroll or diagonal_scroll");
+        static_assert(sizeof...(Area) <= 1,
+                      "there is at most one vertical scroll area");
+        static_assert(((Setup::offset == 0 || Setup::offset < Area::rows)
+                       && ...),
+                      "the vertical offset must be less than the rows "
+                      "of the area");
+        send_commands(bus_t{}, always<deactivate_scroll>{}, always<Area>{}...,
+                      setup, activate_scroll{});
+        _scrolling = true;
+    }
+
+    /** Stops the scroll. */
+    void stop_scroll() {
+        send_commands(bus_t{}, always<deactivate_scroll>{});
+        _scrolling = false;
     }
 
+    bool scrolling() const { return _scrolling; }
+
     template<uint8_t w = 0, uint8_t h = 0>
     uint8_t out(page pg, column col, int32_t n) {
-        set(_i2c, pg, col);
-        _i2c.start_data();
-        uint32_t un;
-        if(n < 0) {
-            send_digit_segmented<w, h>(_i2c, segments::hyphen.segments);
-            un = n * -1;
-        } else un = n;
-        auto n_digits = out_impl<w, h>(un);
-        _i2c.stop_condition();
+        _window.set(_dev, pg, col);
+        uint8_t n_digits;
+        write([&](auto& dev){
+            uint32_t un;
+            if(n < 0) {
+                send_digit_segmented<w, h>(dev, segments::hyphen.segments);
+                un = n * -1;
+            } else un = n;
+            n_digits = out_impl<w, h>(dev, un);
+        });
         return n_digits;
     }
     
     template<uint8_t w = 0, uint8_t h = 0>
     void out(uint8_t n) {
-        _i2c.start_data();
-        out_impl<w, h>(n);
-        _i2c.stop_condition();
+        write([&](auto& dev){ out_impl<w, h>(dev, n); });
     }
     
     template<uint8_t w = 0, uint8_t h = 0, typename... Segs>
     void out(column col, Segs... segs) {
-        set(_i2c, col);
-        _i2c.start_data();
-        (out_impl<w, h>(segs), ...);
-        _i2c.stop_condition();
+        _window.set(_dev, col);
+        write([&](auto& dev){
+            (out_impl<w, h>(dev, segs), ...);
+        });
     }
 
     template<uint8_t w = 0, uint8_t h = 0, typename... Segs>
     void out(page pg, column col, Segs... segs) {
-        set(_i2c, pg, col);
-        _i2c.start_data();
-        (out_impl<w, h>(segs), ...);
-        _i2c.stop_condition();
+        _window.set(_dev, pg, col);
+        write([&](auto& dev){
+            (out_impl<w, h>(dev, segs), ...);
+        });
     }
 
     template<uint8_t w = 0, uint8_t h = 0, int N>
     void out(const uint8_t (&bytes)[N]) {
-        _i2c.start_data();
-        out_impl<w, h>(bytes);
-        _i2c.stop_condition();
+        write([&](auto& dev){ out_impl<w, h>(dev, bytes); }, N);
     }
 
     
     template<int N>
     void out(page pg, const uint8_t (&bytes)[N]) {
-        set(_i2c, pg);
+        _window.set(_dev, pg);
         out(bytes);
     }
     
     template<int N>
     void out(column col, const uint8_t (&bytes)[N]) {
-        set(_i2c, col);
+        _window.set(_dev, col);
         out(bytes);
     }
 
     template<int N>
     void out(page pg, column col, const uint8_t (&bytes)[N]) {
-        set(_i2c, pg, col);
+        _window.set(_dev, pg, col, N);
         out(bytes);
     }
 
+    void out(flash_bytes src) {
+        write([&](auto& dev){ out_impl(dev, src); }, src.size);
+    }
+
+    void out(page pg, flash_bytes src) {
+        _window.set(_dev, pg);
+        out(src);
+    }
+
+    void out(column col, flash_bytes src) {
+        _window.set(_dev, col);
+        out(src);
+    }
+
+    void out(page pg, column col, flash_bytes src) {
+        _window.set(_dev, pg, col, src.size);
+        out(src);
+    }
+
+    /** Draws the text 's' in one data transaction. The page of the
+        window should have the 'pages' of the font times 'Scale', for
+        example, 'page{2, 3}' to a font with 16 rows. Take a look at
+        'send_text()' in 'ssd1306/font.hpp'.
+
+        Example:
+
+          disp.out(page{0, 0}, column{0, 127}, "Menu");
+          disp.out<menu_font>(page{2, 3}, column{8, 127}, "Contrast");
+          disp.out<font5x7, 3>(page{4, 6}, column{0, 127}, "12:30");
+    */
+    template<typename Font = font5x7, uint8_t Scale = 1>
+    void out(page pg, column col, const char* s) {
+        uint16_t len = text_columns<Font, Scale>(s) * Font::pages * Scale;
+        _window.set(_dev, pg, col, len);
+        write([&](auto& dev){ send_text<Font, Scale>(dev, s); }, len);
+    }
+
+    /** Sends the decompressed bytes of 'src', take a look at
+        'ssd1306/packbits.hpp'. */
+    void out(packed_bytes src) {
+        write([&](auto& dev){ out_impl(dev, src); }, src.raw_size);
+    }
+
+    void out(page pg, packed_bytes src) {
+        _window.set(_dev, pg);
+        out(src);
+    }
+
+    void out(column col, packed_bytes src) {
+        _window.set(_dev, col);
+        out(src);
+    }
+
+    void out(page pg, column col, packed_bytes src) {
+        _window.set(_dev, pg, col, src.raw_size);
+        out(src);
+    }
+
     template<typename T>
     void out(uint8_t byte, const repeat<T>& rep) {
-        _i2c.start_data();
-        for(T i{}; i < rep.value; ++i)
-            _i2c.send_byte(byte);
-        _i2c.stop_condition();
+        write([&](auto& dev){ out_impl(dev, byte, rep); }, rep.value);
     }
 
     template<typename T>
     void out(page pg, uint8_t byte, const repeat<T>& rep) {
-        set(_i2c, pg);
+        _window.set(_dev, pg);
         out(byte, rep);
     }
 
     template<typename T>
     void out(column col, uint8_t byte, const repeat<T>& rep) {
-        set(_i2c, col);
+        _window.set(_dev, col);
         out(byte, rep);
     }
     
     template<typename T>
     void out(page pg, column col, uint8_t byte, const repeat<T>& rep) {
-        set(_i2c, pg, col);
+        _window.set(_dev, pg, col, rep.value);
         out(byte, rep);
     }
 };
 
+/** Display on any transport
+
+    Bus: transport of the bytes. It's a type with the static
+         operations start_commands(), start_data(), send_byte() and
+         stop_condition(), like 'i2c' or the SPI interfaces from
+         'ssd1306/spi.hpp'. All the free functions, like 'set()' and
+         'send_digit_segmented()', use only these operations.
+    Window: take a look at 'display'.
+
+    Example:
+
+      using bus = spi<pb5_t, pb3_t, pb1_t, pb2_t>;
+      bus_display<bus> disp{bus{pb5, pb3, pb1, pb2}, turn_on{}};
+*/
+template<typename Bus, typename Window = window_cache>
+class bus_display : public basic_display<Bus, Window> {
+public:
+    using bus_t = Bus;
+
+    bus_display() = default;
+
+    template<typename... Cmds>
+    explicit bus_display(const Bus& bus, Cmds... cmds)
+        : basic_display<Bus, Window>(bus)
+    {
+        detail::send_init<Bus>(cmds...);
+        if(!detail::changes_window<Cmds...>()) this->_window.init();
+        
+        /** clear the whole screen */
+        this->out(0x00, repeat<uint16_t>{128 * 8});
+    }
+};
+
+/** High level interface to a display
+
+    Sda, Scl, SA0: take a look at 'ssd1306/i2c.hpp'.
+    Counter: counting policy of the bus. The counts of all operations,
+             including the ones from 'send_seven_segment.hpp' and
+             'set_page_column.hpp', are reported to it. Take a look at
+             'ssd1306/bus_counter.hpp'.
+    Window: policy that sets the windows. 'window_cache' uses 16 bytes
+            of RAM to skip the commands that don't change anything and
+            'no_window_cache' always sends them. Take a look at
+            'ssd1306/window_cache.hpp'.
+*/
+template<typename Sda, typename Scl, typename SA0 = sa0::off_t,
+         typename Counter = no_counter, typename Window = window_cache>
+class display : public bus_display<i2c<Sda, Scl, SA0, Counter>, Window> {
+public:
+    using i2c_t = ::ssd1306::i2c<Sda, Scl, SA0, Counter>;
+    using counter_t = Counter;
+
+    display() = default;
+    
+    template<typename... Cmds>
+    display(Sda sda, Scl scl, Cmds... cmds)
+        : bus_display<i2c_t, Window>(i2c_t(sda, scl), cmds...)
+    {}
+};
+
+/** Display with a framebuffer
+
+    The output operations draw on a 'framebuffer' with 1 KiB in the
+    MCU RAM instead of sending the bytes to the bus. flush() sends to
+    the device only the regions that were changed since the last
+    flush. This is an option to MCUs with enough RAM, like the
+    ATmega328P.
+
+    The template parameters are the same of 'display'.
+*/
+template<typename Sda, typename Scl, typename SA0 = sa0::off_t,
+         typename Counter = no_counter>
+class buffered_display
+    : public basic_display<framebuffer<i2c<Sda, Scl, SA0, Counter>>>
+{
+public:
+    using i2c_t = ::ssd1306::i2c<Sda, Scl, SA0, Counter>;
+    using counter_t = Counter;
+    using framebuffer_t = framebuffer<i2c_t>;
+
+    buffered_display() = default;
+
+    template<typename... Cmds>
+    buffered_display(Sda sda, Scl scl, Cmds... cmds) {
+        i2c_t{sda, scl};
+        detail::send_init<i2c_t>(cmds...);
+        
+        /** clear the whole screen */
+        this->_dev.invalidate();
+        flush();
+    }
+
+    framebuffer_t& fb() { return this->_dev; }
+    const framebuffer_t& fb() const { return this->_dev; }
+
+    /** Sends the changes to the device, stopping the scroll before
+        if there is any change. */
+    void flush() {
+        if(this->_scrolling && this->_dev.dirty()) this->stop_scroll();
+        this->_dev.flush();
+    }
+};
+
 }
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "ssd1306/mmio.hpp"
+#include "ssd1306/set_page_column.hpp"
+
+#include <avr/io.hpp>
+#include <stdint.h>
+
+namespace ssd1306 {
+
+/** Reader of a serial EEPROM or flash of the 25xx family
+
+    A read starts with the command READ(0x03) followed by the address,
+    MSB first, and the memory shifts out the bytes from that address
+    while CS# is LOW. The bits are shifted in mode 0: the memory
+    changes SO after the falling edge of SCK and the MCU samples it at
+    the rising edge.
+
+    All readers of external memories have the same three operations:
+
+    - begin(addr): starts a sequential read at the address 'addr';
+    - read(): returns the next byte;
+    - end(): finishes the sequential read.
+
+    Any type with them is a source to 'send_from_memory()', for
+    example, 'sim::memory' mocks a memory on the host.
+
+    Sck, Mosi, Miso, Cs: pins connected to SCK, SI, SO and CS#.
+    AddrBytes: number of bytes of the address, 2 to the 25LC256 and 3
+               to the 25Q flashes.
+*/
+template<typename Sck, typename Mosi, typename Miso, typename Cs,
+         uint8_t AddrBytes = 3>
+struct spi_memory {
+    static_assert(AddrBytes >= 1 && AddrBytes <= 3, "");
+
+    spi_memory() = default;
+
+    explicit spi_memory(Sck sck, Mosi mosi, Miso, Cs cs) {
+        avr::io::out(sck, mosi, cs);
+        Cs::high();
+        Sck::low();
+    }
+
+    static void begin(uint32_t addr) {
+        Cs::low();
+        shift_out(0x03);
+        for(uint8_t i{AddrBytes}; i > 0; --i)
+            shift_out(uint8_t(addr >> (8 * (i - 1))));
+    }
+
+    static uint8_t read() {
+        uint8_t byte{0};
+        for(uint8_t i{8}; i > 0; --i) {
+            Sck::high();
+            byte = (byte << 1) | (Miso::is_high() ? 1 : 0);
+            Sck::low();
+        }
+        return byte;
+    }
+
+    static void end() { Cs::high(); }
+
+private:
+    static void shift_out(uint8_t byte) {
+        for(uint8_t i{8}; i > 0; --i) {
+            Mosi::low();
+            if(byte & 0x80) Mosi::high();
+            byte <<= 1;
+            Sck::pulse();
+        }
+    }
+};
+
+/** Reader of a serial EEPROM of the 24Cxx family using the TWI of the
+    ATmega
+
+    The address is written with the slave address in write mode and a
+    repeated start switches to the read mode, which is the random
+    read of the datasheets. Each byte is acknowledged because the
+    number of bytes isn't known, so end() receives one more byte that
+    isn't acknowledged before the stop condition.
+
+    The memory can share the TWI with a display that uses 'twi_i2c',
+    take a look at the bursts of 'send_from_memory()'. The peripheral
+    is enabled by the constructor of 'twi_i2c'.
+
+    Addr: slave address of the memory, 0x50 with A2, A1 and A0 LOW.
+    AddrBytes: number of bytes of the address, 2 to the 24C32 and
+               larger ones.
+    Regs, Layout: take a look at 'twi_i2c'.
+*/
+template<uint8_t Addr = 0x50, uint8_t AddrBytes = 2, typename Regs = mmio,
+         typename Layout = atmega328p_twi>
+struct twi_memory {
+    static_assert(AddrBytes >= 1 && AddrBytes <= 2, "");
+    static constexpr uint8_t twint{1<<7}, twea{1<<6}, twsta{1<<5},
+        twsto{1<<4}, twen{1<<2};
+
+    static void begin(uint32_t addr) {
+        command(twint | twsta | twen);
+        write(uint8_t(Addr << 1));
+        for(uint8_t i{AddrBytes}; i > 0; --i)
+            write(uint8_t(addr >> (8 * (i - 1))));
+        command(twint | twsta | twen);
+        write(uint8_t(Addr << 1 | 1));
+    }
+
+    static uint8_t read() {
+        command(twint | twea | twen);
+        return Regs::read(Layout::twdr);
+    }
+
+    static void end() {
+        command(twint | twen);
+        Regs::write(Layout::twcr, twint | twsto | twen);
+        while(Regs::read(Layout::twcr) & twsto);
+    }
+
+private:
+    static void command(uint8_t twcr) {
+        Regs::write(Layout::twcr, twcr);
+        while(!(Regs::read(Layout::twcr) & twint));
+    }
+
+    static void write(uint8_t byte) {
+        Regs::write(Layout::twdr, byte);
+        command(twint | twen);
+    }
+};
+
+/** Sends the bytes of an external memory from the address 'addr' to
+    the window, without a buffer of the image
+
+    The window is set with 'set()' and the window size is read from
+    the memory in the order of the vertical addressing mode.
+
+    Burst: 0 to stream all bytes in one data transaction, one read()
+           to each send_byte(). The memory and the display should be
+           on different buses. A positive value reads bursts of
+           'Burst' bytes to the stack and sends each burst in one
+           data transaction, so the memory and the display can share
+           the bus. The pointer of the GDDRAM continues where the last
+           burst stopped.
+    Bus: transport of the display, for example, 'i2c', 'twi_i2c' or
+         'spi', or the device of a display.
+    Memory: reader of the memory, like 'spi_memory' or 'twi_memory'.
+
+    precondition: the device is using the vertical addressing mode.
+
+    Example:
+
+      spi_memory<pb5_t, pb3_t, pb4_t, pb2_t> mem{pb5, pb3, pb4, pb2};
+      send_from_memory(disp.device(), mem, 0x1000,
+                       page{0, 7}, column{0, 127});
+*/
+template<uint8_t Burst = 0, typename Bus, typename Memory>
+inline void send_from_memory(Bus&& bus, Memory&& mem, uint32_t addr,
+                             page pg, column col)
+{
+    uint16_t size = uint16_t(pg.end - pg.start + 1)
+        * (col.end - col.start + 1);
+    set(bus, pg, col);
+    if constexpr(Burst == 0) {
+        mem.begin(addr);
+        bus.start_data();
+        for(; size; --size) bus.send_byte(mem.read());
+        bus.stop_condition();
+        mem.end();
+    } else {
+        uint8_t burst[Burst];
+        while(size) {
+            uint8_t n = size < Burst ? size : Burst;
+            mem.begin(addr);
+            for(uint8_t i{0}; i < n; ++i) burst[i] = mem.read();
+            mem.end();
+            bus.start_data();
+            for(uint8_t i{0}; i < n; ++i) bus.send_byte(burst[i]);
+            bus.stop_condition();
+            addr += n;
+            size -= n;
+        }
+    }
+}
+
+}
@@ -0,0 +1,361 @@
+#pragma once
+
+#include "ssd1306/detail/progmem.hpp"
+#include "ssd1306/font5x7.hpp"
+
+#include <stdint.h>
+
+namespace ssd1306 {
+
+/** Glyph drawn as rows of pixels, like the bitmaps of the demo
+    'bitmap_to_gddram'
+
+    c: character of the glyph.
+    width: number of columns [1, 16]. Each glyph has its own width, so
+           the font can be proportional.
+    rows: one row to each line of the font from the top. The column
+          'x' is the bit 'width - 1 - x', so the binary literal of a
+          row is read from left to right.
+
+    Example:
+
+      {'h', 4, {0b1000,
+                0b1000,
+                0b1110,
+                0b1001,
+                0b1001,
+                0b1001,
+                0b1001,
+                0b0000}}
+*/
+template<uint8_t Height>
+struct glyph_rows {
+    char c;
+    uint8_t width;
+    uint16_t rows[Height];
+};
+
+namespace detail {
+
+/** Default 'Used' of a font: all glyphs are packed. */
+inline constexpr char all_glyphs[] = "";
+
+constexpr uint8_t length(const char* s) {
+    uint8_t n{0};
+    while(s[n]) ++n;
+    return n;
+}
+
+/** Characters of a font that are packed: the characters of 'Used'
+    that have a glyph in 'Rows', or all glyphs of 'Rows' if 'Used' is
+    'all_glyphs'. A repeated character is taken once. */
+template<typename Rows, const char* Used>
+struct used_glyphs {
+    static constexpr uint8_t defined{sizeof(Rows::glyphs)
+                                     / sizeof(Rows::glyphs[0])};
+    static constexpr bool all{Used == all_glyphs};
+
+    static constexpr int16_t find(char c) {
+        for(uint8_t i{0}; i < defined; ++i)
+            if(Rows::glyphs[i].c == c) return i;
+        return -1;
+    }
+
+    static constexpr uint8_t candidates()
+    { return all ? defined : length(Used); }
+
+    static constexpr char candidate(uint8_t i)
+    { return all ? Rows::glyphs[i].c : Used[i]; }
+
+    /** True if the candidate 'i' is packed. */
+    static constexpr bool packs(uint8_t i) {
+        char c = candidate(i);
+        if(find(c) < 0) return false;
+        for(uint8_t j{0}; j < i; ++j)
+            if(candidate(j) == c) return false;
+        return true;
+    }
+
+    /** True if all characters of 'Used' have a glyph. */
+    static constexpr bool complete() {
+        for(uint8_t i{0}; i < candidates(); ++i)
+            if(find(candidate(i)) < 0) return false;
+        return true;
+    }
+
+    /** True if the widths of all glyphs are in [1, 16]. */
+    static constexpr bool widths() {
+        for(uint8_t i{0}; i < defined; ++i)
+            if(!Rows::glyphs[i].width || Rows::glyphs[i].width > 16)
+                return false;
+        return true;
+    }
+
+    static constexpr uint8_t count() {
+        uint8_t n{0};
+        for(uint8_t i{0}; i < candidates(); ++i) n += packs(i);
+        return n;
+    }
+
+    static constexpr uint16_t columns() {
+        uint16_t n{0};
+        for(uint8_t i{0}; i < candidates(); ++i)
+            if(packs(i)) n += Rows::glyphs[find(candidate(i))].width;
+        return n;
+    }
+
+    static constexpr uint8_t first() {
+        uint8_t v{0xff};
+        for(uint8_t i{0}; i < candidates(); ++i)
+            if(packs(i) && uint8_t(candidate(i)) < v)
+                v = uint8_t(candidate(i));
+        return v;
+    }
+
+    static constexpr uint8_t last() {
+        uint8_t v{0};
+        for(uint8_t i{0}; i < candidates(); ++i)
+            if(packs(i) && uint8_t(candidate(i)) > v)
+                v = uint8_t(candidate(i));
+        return v;
+    }
+};
+
+/** Tables of a font in the flash
+
+    index: glyph of the character 'first + i', or 0xff if it isn't
+           packed.
+    width: number of columns of each glyph.
+    offset: first byte of each glyph in 'bytes', split in the low and
+            high bytes to be read byte by byte from the flash.
+    bytes: columns of all glyphs from left to right, each column has
+           'Pages' bytes from the top page to the bottom one, which is
+           the order of the vertical addressing mode.
+*/
+template<uint8_t Span, uint8_t N, uint16_t Bytes>
+struct font_tables {
+    uint8_t index[Span];
+    uint8_t width[N];
+    uint8_t offset_lo[N];
+    uint8_t offset_hi[N];
+    uint8_t bytes[Bytes];
+};
+
+} //namespace detail
+
+/** Font converted at compile time from row bitmaps to glyphs of the
+    GDDRAM
+
+    The glyphs are rotated like 'toGDDRAM()' of the demo
+    'bitmap_to_gddram', but with any width and height: the row 'r' is
+    the bit 'r % 8' of the page 'r / 8' of the glyph, so a font with
+    16 rows has two pages. Only the glyphs of the characters in 'Used'
+    are placed in the flash, a font with all ASCII glyphs costs only
+    what a menu prints.
+
+    Rows: type with the definition of the font:
+          'static constexpr uint8_t height' with the number of rows
+          [1, 64], 'static constexpr uint8_t spacing' with the empty
+          columns after each glyph and
+          'static constexpr glyph_rows<height> glyphs[]'.
+    Used: null-terminated string with the characters that are used,
+          all glyphs are packed if it's omitted. It's a constexpr
+          array with static storage, like a 'constexpr char[]' at
+          namespace scope.
+
+    The characters that aren't packed aren't drawn.
+
+    Example:
+
+      struct menu_rows {
+          static constexpr uint8_t height{8};
+          static constexpr uint8_t spacing{1};
+          static constexpr glyph_rows<8> glyphs[] = {
+              {'h', 4, {0b1000, 0b1000, 0b1110, 0b1001,
+                        0b1001, 0b1001, 0b1001, 0b0000}},
+              {'i', 1, {0b1, 0b0, 0b1, 0b1, 0b1, 0b1, 0b1, 0b0}},
+              ...
+          };
+      };
+      constexpr char menu_chars[] = "hi";
+      using menu_font = font<menu_rows, menu_chars>;
+
+      disp.out<menu_font>(page{0, 0}, column{0, 127}, "hi");
+*/
+template<typename Rows, const char* Used = detail::all_glyphs>
+struct font {
+private:
+    using used = detail::used_glyphs<Rows, Used>;
+    static_assert(Rows::height >= 1 && Rows::height <= 64, "");
+    static_assert(used::complete(),
+                  "all used characters must have a glyph");
+    static_assert(used::widths(), "the width must be in [1, 16]");
+    static_assert(used::count() >= 1 && used::count() < 0xff, "");
+
+    static constexpr uint8_t first{used::first()};
+    static constexpr uint8_t span{uint8_t(used::last() - first + 1)};
+    static constexpr uint8_t count{used::count()};
+public:
+    static constexpr uint8_t pages{(Rows::height + 7) / 8};
+    static constexpr uint8_t spacing{Rows::spacing};
+    static constexpr uint16_t size{used::columns() * pages};
+
+    using tables_t = detail::font_tables<span, count, size>;
+private:
+    static constexpr tables_t make() {
+        tables_t t{};
+        for(uint8_t i{0}; i < span; ++i) t.index[i] = 0xff;
+        uint8_t g{0};
+        uint16_t pos{0};
+        for(uint8_t i{0}; i < used::candidates(); ++i) {
+            if(!used::packs(i)) continue;
+            const auto& src = Rows::glyphs[used::find(used::candidate(i))];
+            t.index[uint8_t(src.c) - first] = g;
+            t.width[g] = src.width;
+            t.offset_lo[g] = uint8_t(pos);
+            t.offset_hi[g] = uint8_t(pos >> 8);
+            for(uint8_t x{0}; x < src.width; ++x, pos += pages)
+                for(uint8_t r{0}; r < Rows::height; ++r)
+                    if(src.rows[r] >> (src.width - 1 - x) & 1)
+                        t.bytes[pos + r / 8] |= uint8_t(1 << (r % 8));
+            ++g;
+        }
+        return t;
+    }
+
+    /** Glyph of 'c' or 0xff. */
+    static uint8_t glyph(char c) {
+        uint8_t i = uint8_t(c) - first;
+        if(i >= span) return 0xff;
+        return detail::read_flash(&tables.index[i]);
+    }
+public:
+    static const tables_t tables;
+
+    /** Number of columns of 'c', including the spacing. */
+    static uint8_t columns(char c) {
+        uint8_t g = glyph(c);
+        if(g == 0xff) return 0;
+        return detail::read_flash(&tables.width[g]) + spacing;
+    }
+
+    /** Calls f(byte) to each byte of the glyph of 'c' followed by the
+        spacing, 'pages' bytes to each column. */
+    template<typename F>
+    static void for_each_byte(char c, F&& f) {
+        uint8_t g = glyph(c);
+        if(g == 0xff) return;
+        uint16_t offset = detail::read_flash(&tables.offset_lo[g])
+            | uint16_t(detail::read_flash(&tables.offset_hi[g])) << 8;
+        const uint8_t* p = &tables.bytes[offset];
+        const uint8_t* end = p + detail::read_flash(&tables.width[g]) * pages;
+        for(; p != end; ++p) f(detail::read_flash(p));
+        for(uint8_t i{0}; i < spacing * pages; ++i) f(uint8_t(0x00));
+    }
+
+    template<typename Dev>
+    static void send(Dev&& dev, char c)
+    { for_each_byte(c, [&](uint8_t b){ dev.send_byte(b); }); }
+};
+
+template<typename Rows, const char* Used>
+const typename font<Rows, Used>::tables_t font<Rows, Used>::tables
+SSD1306_PROGMEM = font<Rows, Used>::make();
+
+namespace detail {
+
+/** Each bit of a nibble repeated 'Scale' times: the bit 'i' of the
+    nibble is the bits [i * Scale, (i + 1) * Scale) of the value, which
+    is split in the low and high bytes. */
+template<uint8_t Scale>
+struct nibble_expansion {
+    struct table_t { uint8_t lo[16], hi[16]; };
+
+    static constexpr table_t make() {
+        table_t t{};
+        for(uint8_t n{0}; n < 16; ++n) {
+            uint16_t v{0};
+            for(uint8_t i{0}; i < 4; ++i)
+                if(n >> i & 1) v |= uint16_t((1 << Scale) - 1) << (i * Scale);
+            t.lo[n] = uint8_t(v);
+            t.hi[n] = uint8_t(v >> 8);
+        }
+        return t;
+    }
+
+    static const table_t value;
+
+    static uint16_t expand(uint8_t nibble) {
+        return detail::read_flash(&value.lo[nibble])
+            | uint16_t(detail::read_flash(&value.hi[nibble])) << 8;
+    }
+};
+
+template<uint8_t Scale>
+const typename nibble_expansion<Scale>::table_t
+nibble_expansion<Scale>::value SSD1306_PROGMEM =
+    nibble_expansion<Scale>::make();
+
+/** Sends the column 'b' of one page scaled by 'Scale': each bit is
+    repeated 'Scale' times over 'Scale' pages and the column is
+    repeated 'Scale' times. */
+template<uint8_t Scale, typename Dev>
+inline void send_scaled_column(Dev& dev, uint8_t b) {
+    uint8_t bytes[Scale];
+    if constexpr(Scale == 2) {
+        //one nibble to each page
+        bytes[0] = uint8_t(nibble_expansion<2>::expand(b & 0x0f));
+        bytes[1] = uint8_t(nibble_expansion<2>::expand(b >> 4));
+    } else if constexpr(Scale == 4) {
+        //one nibble to each two pages
+        uint16_t lo = nibble_expansion<4>::expand(b & 0x0f);
+        uint16_t hi = nibble_expansion<4>::expand(b >> 4);
+        bytes[0] = uint8_t(lo);
+        bytes[1] = uint8_t(lo >> 8);
+        bytes[2] = uint8_t(hi);
+        bytes[3] = uint8_t(hi >> 8);
+    } else {
+        //24 bits: the 12 bits of the high nibble after the low ones
+        uint16_t lo = nibble_expansion<3>::expand(b & 0x0f);
+        uint16_t hi = nibble_expansion<3>::expand(b >> 4);
+        bytes[0] = uint8_t(lo);
+        bytes[1] = uint8_t(lo >> 8) | uint8_t(hi << 4);
+        bytes[2] = uint8_t(hi >> 4);
+    }
+    for(uint8_t x{0}; x < Scale; ++x)
+        for(uint8_t p{0}; p < Scale; ++p) dev.send_byte(bytes[p]);
+}
+
+} //namespace detail
+
+/** Number of columns of the text 's' using 'Font' scaled by
+    'Scale'. */
+template<typename Font, uint8_t Scale = 1>
+inline uint16_t text_columns(const char* s) {
+    uint16_t n{0};
+    for(; *s; ++s) n += Font::columns(*s);
+    return n * Scale;
+}
+
+/** Sends the text 's' using 'Font', one glyph after the other
+
+    Scale: 1, or 2, 3 or 4 to draw a font of one page with glyphs
+           'Scale' times larger over 'Scale' pages. The pixels are
+           expanded while they are sent using lookup tables of 32
+           bytes in the flash, so only the small font is stored and
+           the bus carries only the scaled pixels.
+*/
+template<typename Font, uint8_t Scale = 1, typename Dev>
+inline void send_text(Dev&& dev, const char* s) {
+    static_assert(Scale >= 1 && Scale <= 4, "");
+    static_assert(Scale == 1 || Font::pages == 1,
+                  "only the fonts of one page can be scaled");
+    auto scaled = [&](uint8_t b)
+    { detail::send_scaled_column<Scale>(dev, b); };
+    for(; *s; ++s) {
+        if constexpr(Scale == 1) Font::send(dev, *s);
+        else Font::for_each_byte(*s, scaled);
+    }
+}
+
+}
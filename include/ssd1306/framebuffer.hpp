@@ -0,0 +1,170 @@
+#pragma once
+
+#include "ssd1306/detail/window_cursor.hpp"
+#include "ssd1306/set_page_column.hpp"
+
+#include <stdint.h>
+
+namespace ssd1306 {
+
+/** Copy of the GDDRAM in the MCU RAM with tracking of the changes
+
+    The buffer has 1 KiB(128x64 dots) and it uses the layout of the
+    vertical addressing mode: the byte of the page 'p' and column 'c'
+    is the byte at the index 'c * 8 + p'.
+
+    It offers the same methods of 'i2c' that are used to send data to
+    the GDDRAM, so the free functions like 'set()' and
+    'send_digit_segmented()' can draw on it: start_commands(),
+    start_data(), send_byte() and stop_condition(). The only commands
+    that are understood are 0x21(column address) and 0x22(page
+    address), the other ones are ignored and they should be sent
+    directly to the bus.
+
+    The columns that are changed are recorded as one span of columns
+    to each page. A byte that is written with the value that it
+    already has isn't considered a change. flush() sends to the device
+    only the regions that were changed.
+
+    I2C: type of the bus, for example, 'i2c<pb0_t, pb2_t>'.
+*/
+template<typename I2C>
+class framebuffer {
+    uint8_t _buf[8 * 128];
+    uint8_t _first[8], _last[8];
+    detail::window_cursor _w;
+    detail::window_commands _cmds;
+    bool _commands{false};
+
+    /** Bytes of overhead to send one rectangle: the commands 0x22 and
+        0x21 with their arguments plus the slave address and the
+        control byte of two transactions. */
+    static constexpr uint8_t rect_overhead{10};
+
+    uint16_t span_cost(uint8_t from, uint8_t to,
+                       uint8_t& first, uint8_t& last) const
+    {
+        first = 0xff;
+        last = 0;
+        for(uint8_t p{from}; p <= to; ++p) {
+            if(_first[p] > _last[p]) continue;
+            if(_first[p] < first) first = _first[p];
+            if(_last[p] > last) last = _last[p];
+        }
+        return rect_overhead + uint16_t(to - from + 1) * (last - first + 1);
+    }
+
+    void send_rect(uint8_t from, uint8_t to, uint8_t first, uint8_t last) {
+        set(I2C{}, page{from, to}, column{first, last});
+        I2C::start_data();
+        for(uint16_t c{first}; c <= last; ++c)
+            for(uint8_t p{from}; p <= to; ++p)
+                I2C::send_byte(_buf[c * 8 + p]);
+        I2C::stop_condition();
+    }
+public:
+    framebuffer() {
+        for(auto& b : _buf) b = 0x00;
+        for(auto& f : _first) f = 0xff;
+        for(auto& l : _last) l = 0;
+    }
+
+    /** Sets all bytes to zero. */
+    void clear() {
+        for(uint8_t c{}; c < 128; ++c)
+            for(uint8_t p{}; p < 8; ++p)
+                write(p, c, 0x00);
+    }
+
+    uint8_t read(uint8_t pg, uint8_t col) const
+    { return _buf[col * 8 + pg]; }
+
+    void write(uint8_t pg, uint8_t col, uint8_t byte) {
+        auto& b = _buf[col * 8 + pg];
+        if(b == byte) return;
+        b = byte;
+        if(col < _first[pg]) _first[pg] = col;
+        if(col > _last[pg]) _last[pg] = col;
+    }
+
+    /** Turns on or off the dot at the column 'x' and row 'y'. */
+    void dot(uint8_t x, uint8_t y, bool on = true) {
+        uint8_t b = read(y / 8, x);
+        if(on) b |= 1 << (y % 8);
+        else b &= ~(1 << (y % 8));
+        write(y / 8, x, b);
+    }
+
+    /** Considers the whole buffer as changed. */
+    void invalidate() {
+        for(auto& f : _first) f = 0;
+        for(auto& l : _last) l = 127;
+    }
+
+    bool dirty() const {
+        for(uint8_t p{}; p < 8; ++p)
+            if(_first[p] <= _last[p]) return true;
+        return false;
+    }
+
+    void start_commands() {
+        _commands = true;
+        _cmds.reset();
+    }
+
+    void start_data() { _commands = false; }
+
+    void send_byte(uint8_t byte) {
+        if(_commands) _cmds(_w, byte);
+        else {
+            write(_w.page, _w.col, byte);
+            _w.advance();
+        }
+    }
+
+    void stop_condition() {}
+
+    /** Sends the changed regions to the device
+
+        The pages with changes are grouped in rectangles, each one is
+        sent using the tightest windows 0x22 and 0x21 followed by one
+        data transaction. The groups are chosen to minimize the number
+        of bytes on the bus, considering that each rectangle costs
+        'rect_overhead' bytes and that the unchanged bytes inside of a
+        rectangle are sent again.
+
+        precondition: the device is using the vertical addressing
+        mode.
+    */
+    void flush() {
+        //cost[j] is the minimal cost to send the pages [0, j)
+        uint16_t cost[9];
+        uint8_t from[9];
+        cost[0] = 0;
+        for(uint8_t j{1}; j <= 8; ++j) {
+            cost[j] = cost[j - 1];
+            from[j] = j;
+            if(_first[j - 1] > _last[j - 1]) continue;
+            cost[j] = 0xffff;
+            for(uint8_t i{j}; i > 0; --i) {
+                uint8_t first, last;
+                auto c = cost[i - 1] + span_cost(i - 1, j - 1, first, last);
+                if(c < cost[j]) {
+                    cost[j] = c;
+                    from[j] = i - 1;
+                }
+            }
+        }
+        for(uint8_t j{8}; j > 0;) {
+            if(from[j] == j) { --j; continue; }
+            uint8_t first, last;
+            span_cost(from[j], j - 1, first, last);
+            send_rect(from[j], j - 1, first, last);
+            j = from[j];
+        }
+        for(auto& f : _first) f = 0xff;
+        for(auto& l : _last) l = 0;
+    }
+};
+
+}
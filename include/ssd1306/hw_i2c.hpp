@@ -0,0 +1,213 @@
+#pragma once
+
+#include "ssd1306/i2c.hpp"
+#include "ssd1306/mmio.hpp"
+
+#include <avr/io.hpp>
+
+namespace ssd1306 {
+
+namespace detail {
+
+/** Bytes of the I2C protocol of the SSD1306 over a physical layer
+
+    Phy offers start_condition(), shift_out() and stop_condition(),
+    the other operations of 'i2c' are built on them, so all I2C
+    interfaces can be used by 'bus_display', the free functions and
+    the transaction planner.
+*/
+template<typename Phy, typename SA0, typename Counter>
+struct i2c_protocol {
+    using counter_t = Counter;
+
+    static constexpr uint8_t addr() { return 0b01111000 | SA0::bv; }
+
+    static void send_slave_addr() {
+        Counter::addr_byte();
+        Phy::shift_out(addr());
+    }
+
+    static void send_ctrl_byte(dc mode, co co_bit = co::off) {
+        uint8_t byte{0x00};
+        if(co_bit == co::on) byte |= (1<<7);
+        if(mode == dc::data) byte |= (1<<6);
+        Counter::ctrl_byte();
+        Phy::shift_out(byte);
+    }
+
+    static void send_byte(uint8_t byte) {
+        Counter::payload_byte();
+        Phy::shift_out(byte);
+    }
+
+    static void start_commands() {
+        Phy::start_condition();
+        send_slave_addr();
+        send_ctrl_byte(dc::command);
+    }
+
+    static void start_data() {
+        Phy::start_condition();
+        send_slave_addr();
+        send_ctrl_byte(dc::data);
+    }
+};
+
+} //namespace detail
+
+/** Value of TWBR to the SCL frequency 'f_scl' when the prescaler is
+    1: f_scl = f_cpu / (16 + 2 * TWBR).
+
+    The value is clamped to the range of TWBR: 0 when 'f_scl' is
+    greater than 'f_cpu / 16', which is the fastest SCL, and 255 when
+    'f_scl' is less than 'f_cpu / 526', which is the slowest one with
+    the prescaler 1.
+
+    Example: twi_bitrate(16000000, 400000) == 12
+*/
+constexpr uint8_t twi_bitrate(uint32_t f_cpu, uint32_t f_scl) {
+    uint32_t ratio = f_cpu / f_scl;
+    if(ratio <= 16) return 0;
+    return ratio - 16 > 2 * 255 ? 255 : (ratio - 16) / 2;
+}
+
+/** I2C using the TWI peripheral of the ATmega
+
+    The bits are shifted by the hardware at the rate set by TWBR, so
+    the bus runs at the Fast-mode(400kHz) or faster regardless of the
+    code that is executed, and each byte costs one write to TWDR, one
+    write to TWCR and a wait for TWINT.
+
+    It offers the same operations of 'i2c'. Like the bit-banged
+    interface, the status codes of TWSR aren't checked, the SSD1306
+    is a write-only slave.
+
+    SA0, Counter: take a look at 'ssd1306/i2c.hpp'.
+    Regs: register policy, take a look at 'ssd1306/mmio.hpp'.
+    Layout: addresses of the registers, for example,
+            'atmega328p_twi'.
+
+    Example:
+
+      using bus = twi_i2c<>;
+      bus_display<bus> disp{bus{twi_bitrate(F_CPU, 400000)}, turn_on{}};
+*/
+template<typename SA0 = sa0::off_t, typename Counter = no_counter,
+         typename Regs = mmio, typename Layout = atmega328p_twi>
+struct twi_i2c
+    : detail::i2c_protocol<twi_i2c<SA0, Counter, Regs, Layout>, SA0, Counter>
+{
+    static constexpr uint8_t twint{1<<7}, twsta{1<<5}, twsto{1<<4},
+        twen{1<<2};
+
+    twi_i2c() = default;
+
+    /** Enables the peripheral with the prescaler 1. */
+    explicit twi_i2c(uint8_t twbr, SA0 = SA0{}) {
+        Regs::write(Layout::twsr, 0x00);
+        Regs::write(Layout::twbr, twbr);
+        Regs::write(Layout::twcr, twen);
+    }
+
+    static void start_condition() {
+        Counter::start();
+        Regs::write(Layout::twcr, twint | twsta | twen);
+        wait();
+    }
+
+    /** Sends one byte. The byte isn't seen by the counter. */
+    static void shift_out(uint8_t byte) {
+        Regs::write(Layout::twdr, byte);
+        Regs::write(Layout::twcr, twint | twen);
+        wait();
+    }
+
+    /** Waits for the end of the stop condition, so a start condition
+        can be requested just after it. */
+    static void stop_condition() {
+        Counter::stop();
+        Regs::write(Layout::twcr, twint | twsto | twen);
+        while(Regs::read(Layout::twcr) & twsto);
+    }
+
+private:
+    static void wait()
+    { while(!(Regs::read(Layout::twcr) & twint)); }
+};
+
+/** I2C using the USI of the ATtiny in the two-wire mode
+
+    The shift register puts each bit on SDA and the 4-bit counter
+    counts the edges of SCL, which are generated by strobes of
+    USITC. A byte costs sixteen writes to USICR plus two to the
+    acknowledge clock, there isn't a loop that tests the bits.
+
+    The start and stop conditions are generated through the pins, the
+    USI drives SDA only when its pin is HIGH.
+
+    Sda, Scl: pins SDA and SCL of the USI.
+    SA0, Counter: take a look at 'ssd1306/i2c.hpp'.
+    Regs: register policy, take a look at 'ssd1306/mmio.hpp'.
+    Layout: addresses of the registers, for example, 'attiny85_usi'.
+*/
+template<typename Sda, typename Scl, typename SA0 = sa0::off_t,
+         typename Counter = no_counter, typename Regs = mmio,
+         typename Layout = attiny85_usi>
+struct usi_i2c
+    : detail::i2c_protocol<usi_i2c<Sda, Scl, SA0, Counter, Regs, Layout>,
+                           SA0, Counter>
+{
+    static constexpr uint8_t usiwm1{1<<5}, usics1{1<<3}, usiclk{1<<1},
+        usitc{1<<0};
+    static constexpr uint8_t usisif{1<<7}, usioif{1<<6}, usipf{1<<5},
+        usidc{1<<4};
+
+    usi_i2c() = default;
+
+    explicit usi_i2c(Sda sda, Scl scl, SA0 = SA0{}) {
+        avr::io::out(sda, scl);
+        Sda::high();
+        Scl::high();
+        Regs::write(Layout::usidr, 0xff);
+        Regs::write(Layout::usicr, usiwm1 | usics1 | usiclk);
+        Regs::write(Layout::usisr, usisif | usioif | usipf | usidc);
+    }
+
+    /** SDA falls while SCL is HIGH and after that SDA is released to
+        the shift register. */
+    static void start_condition() {
+        Counter::start();
+        Sda::low();
+        Scl::low();
+        Sda::high();
+    }
+
+    /** Shift out the eight bits of a byte, MSB first, followed by the
+        acknowledge clock with SDA released. The byte isn't seen by the
+        counter. */
+    static void shift_out(uint8_t byte) {
+        Regs::write(Layout::usidr, byte);
+        transfer(0x00);
+        Regs::write(Layout::usidr, 0xff);
+        transfer(0x0e);
+    }
+
+    static void stop_condition() {
+        Counter::stop();
+        Sda::low();
+        Scl::high();
+        Sda::high();
+    }
+
+private:
+    /** Toggles SCL until the counter overflows, 'count' is its
+        initial value: 0 to eight bits and 14 to one bit. All flags are
+        cleared with the counter, like in the setup. */
+    static void transfer(uint8_t count) {
+        Regs::write(Layout::usisr, usisif | usioif | usipf | usidc | count);
+        do Regs::write(Layout::usicr, usiwm1 | usics1 | usiclk | usitc);
+        while(!(Regs::read(Layout::usisr) & usioif));
+    }
+};
+
+}
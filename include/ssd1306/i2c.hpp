@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ssd1306/bus_counter.hpp"
 #include "ssd1306/detail/global.hpp"
 
 #include <avr/io.hpp>
@@ -16,11 +17,100 @@ SSD1306_INLINE_GLOBAL(off)
 enum class dc { data, command };
 enum class co { on, off };
 
+namespace detail {
+
+/** PORT register of a pin that declares it through 'port_type', like
+    'port_pin' and the mock pins of 'ssd1306::sim', or void. */
+template<typename Pin, typename = void>
+struct port_of { using type = void; };
+
+template<typename Pin>
+struct port_of<Pin, decltype(void(sizeof(typename Pin::port_type)))>
+{ using type = typename Pin::port_type; };
+
+template<typename A, typename B>
+struct same_type { static constexpr bool value{false}; };
+
+template<typename A>
+struct same_type<A, A> { static constexpr bool value{true}; };
+
+template<typename Sda, typename Scl>
+constexpr bool same_port() {
+    using port = typename port_of<Sda>::type;
+    return !same_type<port, void>::value
+        && same_type<port, typename port_of<Scl>::type>::value;
+}
+
+template<typename Pin, typename = void>
+struct has_out { static constexpr bool value{false}; };
+
+template<typename Pin>
+struct has_out<Pin, decltype(void(&Pin::out))>
+{ static constexpr bool value{true}; };
+
+/** Configures a pin as output, using avrIO to its pins. */
+template<typename Pin>
+inline void output(Pin pin) {
+    if constexpr(has_out<Pin>::value) Pin::out();
+    else avr::io::out(pin);
+}
+
+template<typename... Pins>
+inline void outputs(Pins... pins) { (output(pins), ...); }
+
+/** Shifts out a byte writing SDA and SCL together
+
+    The PORT register is read once, at the beginning of the byte, and
+    the four combinations of the levels of SDA and SCL are computed
+    from it. A bit costs at most three writes to the port: one to
+    change SDA, which is skipped when the bit is equal to the previous
+    one, and two to the pulse of SCL. The loop that uses the pins costs
+    up to four writes to each bit: SDA low, SDA high, SCL high and SCL
+    low. 'test/test_same_port.cpp' counts the writes of both paths on
+    the host. The cycles weren't measured on the MCU, they are
+    estimated from the instruction timings of the AVR: a write to the
+    port(OUT) takes one cycle and a write to a pin(SBI/CBI) takes two.
+
+    precondition: the other pins of the port aren't changed by an
+    interrupt while the byte is sent, otherwise the change is lost.
+*/
+template<typename Sda, typename Scl>
+inline void shift_out_same_port(uint8_t byte) {
+    using port = typename Sda::port_type;
+    const uint8_t v = port::read() & ~Scl::bv;
+    port::write(v);
+    const uint8_t lo = v & ~Sda::bv, lo_scl = lo | Scl::bv;
+    const uint8_t hi = lo | Sda::bv, hi_scl = hi | Scl::bv;
+    bool sda = v & Sda::bv;
+    for(uint8_t i{8}; i > 0; --i) {
+        if(byte & 0x80) {
+            if(!sda) port::write(hi);
+            port::write(hi_scl);
+            port::write(hi);
+            sda = true;
+        } else {
+            if(sda) port::write(lo);
+            port::write(lo_scl);
+            port::write(lo);
+            sda = false;
+        }
+        byte <<= 1;
+    }
+    //acknowledge bit
+    port::write(sda ? hi_scl : lo_scl);
+    port::write(sda ? hi : lo);
+}
+
+} //namespace detail
+
 /** I2C communication interface 
 
     Sda: pin that represents the bus data signal SDA.
     Scl: pin that represents the bus clock signal SCL.
     SA0: slave address bit. The default value is zero(off).
+    Counter: policy that counts the bus events. The default one,
+             'no_counter', doesn't add any code. Take a look at
+             'ssd1306/bus_counter.hpp'.
 
     This abstraction follows the specification from the section '8.1.5
     MCU I2C Interface' of datasheet.
@@ -29,14 +119,17 @@ enum class co { on, off };
     device: start_condition(), send_slave_addr(), send_ctrl_byte(),
     send_byte() and stop_condition().
 */
-template<typename Sda, typename Scl, typename SA0 = sa0::off_t>
+template<typename Sda, typename Scl, typename SA0 = sa0::off_t,
+         typename Counter = no_counter>
 struct i2c {
+    using counter_t = Counter;
+
     static constexpr uint8_t addr() { return 0b01111000 | SA0::bv; }
     
     i2c() = default;
     
     explicit i2c(Sda sda, Scl scl, SA0 = SA0{})
-    { avr::io::out(sda, scl); }
+    { detail::outputs(sda, scl); }
 
     /** The first operation to send a command or a data byte to GDDRAM
         is to initiate the communication by a start condition. The
@@ -45,7 +138,10 @@ struct i2c {
 
         precondition: SDA and SCL are high by pull-up resistors. 
     */
-    static void start_condition() { Sda::low(); }
+    static void start_condition() {
+        Counter::start();
+        Sda::low();
+    }
 
     /** Send the slave address of the device. 
 
@@ -56,7 +152,10 @@ struct i2c {
         precondition: a start condition should be sent before this
         operation.
     */
-    static void send_slave_addr() { send_byte(addr()); }
+    static void send_slave_addr() {
+        Counter::addr_byte();
+        shift_out(addr());
+    }
 
     /** Send a control byte.
 
@@ -101,7 +200,8 @@ struct i2c {
         uint8_t byte{0x00};
         if(co_bit == co::on) byte |= (1<<7);
         if(mode == dc::data) byte |= (1<<6);
-        send_byte(byte);
+        Counter::ctrl_byte();
+        shift_out(byte);
     }
     
     /** Send one byte.
@@ -129,15 +229,33 @@ struct i2c {
         precondition: a control byte should be sent before this call. 
     */
     static void send_byte(uint8_t byte) {
-        Scl::low();
-        for(uint8_t i{8}; i > 0; --i) {
-            Sda::low();
-            if(byte & 0x80) Sda::high();
-            byte <<= 1;
+        Counter::payload_byte();
+        shift_out(byte);
+    }
+
+    /** Shift out the eight bits of a byte, MSB first, followed by the
+        acknowledge clock. The byte isn't seen by the counter.
+
+        When Sda and Scl declare the same port, the levels of both pins
+        are written together, take a look at
+        'detail::shift_out_same_port()'. The pins of avrIO don't
+        declare their port, so this is used only with pins like
+        'port_pin'.
+    */
+    static void shift_out(uint8_t byte) {
+        if constexpr(detail::same_port<Sda, Scl>())
+            detail::shift_out_same_port<Sda, Scl>(byte);
+        else {
+            Scl::low();
+            for(uint8_t i{8}; i > 0; --i) {
+                Sda::low();
+                if(byte & 0x80) Sda::high();
+                byte <<= 1;
+                Scl::pulse();
+            }
+            //acknowledge bit
             Scl::pulse();
         }
-        //acknowledge bit
-        Scl::pulse();
     }
     
     /** The operation should be finished by a stop condition. The stop
@@ -147,6 +265,7 @@ struct i2c {
     static void stop_condition() {
         //The stop condition is established by pulling the SDA from low to
         //high while the SCL stays high.
+        Counter::stop();
         Scl::high();
         Sda::high();
     }
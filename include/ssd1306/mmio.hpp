@@ -0,0 +1,77 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace ssd1306 {
+
+/** Access to the memory mapped I/O registers
+
+    The hardware backends, like 'hw_spi', don't touch the registers
+    directly, they call read() and write() of a register policy with
+    the address of the register in the data space. This is the policy
+    used on the MCU. The host simulation offers 'sim::registers',
+    which has the same interface and emulates the peripherals, so the
+    backends can be tested on a Linux box.
+*/
+struct mmio {
+    static uint8_t read(uint16_t addr)
+    { return *reinterpret_cast<volatile uint8_t*>(addr); }
+
+    static void write(uint16_t addr, uint8_t v)
+    { *reinterpret_cast<volatile uint8_t*>(addr) = v; }
+};
+
+/** Registers of the SPI of the ATmega48/88/168/328 family. The
+    addresses are in the data space. */
+struct atmega328p_spi {
+    static constexpr uint16_t spcr{0x4c};
+    static constexpr uint16_t spsr{0x4d};
+    static constexpr uint16_t spdr{0x4e};
+};
+
+/** Registers of the TWI of the ATmega48/88/168/328 family. The
+    addresses are in the data space. */
+struct atmega328p_twi {
+    static constexpr uint16_t twbr{0xb8};
+    static constexpr uint16_t twsr{0xb9};
+    static constexpr uint16_t twdr{0xbb};
+    static constexpr uint16_t twcr{0xbc};
+};
+
+/** Registers of the ports B, C and D of the ATmega48/88/168/328
+    family. The addresses are in the data space. */
+struct atmega328p_portb {
+    static constexpr uint16_t pin{0x23};
+    static constexpr uint16_t ddr{0x24};
+    static constexpr uint16_t port{0x25};
+};
+
+struct atmega328p_portc {
+    static constexpr uint16_t pin{0x26};
+    static constexpr uint16_t ddr{0x27};
+    static constexpr uint16_t port{0x28};
+};
+
+struct atmega328p_portd {
+    static constexpr uint16_t pin{0x29};
+    static constexpr uint16_t ddr{0x2a};
+    static constexpr uint16_t port{0x2b};
+};
+
+/** Registers of the port B of the ATtiny13/25/45/85. The addresses
+    are in the data space. */
+struct attiny85_portb {
+    static constexpr uint16_t pin{0x36};
+    static constexpr uint16_t ddr{0x37};
+    static constexpr uint16_t port{0x38};
+};
+
+/** Registers of the USI of the ATtiny25/45/85. The addresses are in
+    the data space. */
+struct attiny85_usi {
+    static constexpr uint16_t usicr{0x2d};
+    static constexpr uint16_t usisr{0x2e};
+    static constexpr uint16_t usidr{0x2f};
+};
+
+}
@@ -0,0 +1,210 @@
+#pragma once
+
+#include "ssd1306/display.hpp"
+#include "ssd1306/i2c.hpp"
+#include "ssd1306/set_page_column.hpp"
+
+#include <stdint.h>
+
+namespace ssd1306 {
+
+/** List of the SDA pins of a 'multi_i2c', one to each panel. */
+template<typename... Sda>
+struct lanes {};
+
+template<typename Scl, typename Lanes, typename SA0 = sa0::off_t,
+         typename Counter = no_counter>
+struct multi_i2c;
+
+/** Several I2C buses that share SCL and that are shifted together
+
+    Each panel has its own SDA pin and all panels receive the clock
+    from the same SCL pin. All pins are on the same port, so one write
+    to the port puts one bit on each SDA and one pulse of SCL clocks
+    the bits into all panels: N panels are updated in the bus time of
+    one.
+
+    The operations of 'i2c' send the same byte to all panels, so it's
+    a transport to 'bus_display', 'set()', 'send_commands()' and so
+    on. send_lanes() sends one byte to each panel.
+
+    Scl: pin of the shared clock.
+    Lanes: 'lanes<Sda...>' with the SDA pin of each panel.
+    SA0, Counter: take a look at 'ssd1306/i2c.hpp'. All panels use
+                  the same slave address. The counter sees the bytes
+                  of the bus once.
+
+    The pins declare their port through 'port_type', take a look at
+    'ssd1306/port_pin.hpp'.
+
+    Example:
+
+      using bus = multi_i2c<pb2_t, lanes<pb0_t, pb1_t>>;
+      bus::start_data();
+      const uint8_t bytes[] = {0xff, 0x81};
+      bus::send_lanes(bytes);
+      bus::stop_condition();
+*/
+template<typename Scl, typename... Sda, typename SA0, typename Counter>
+struct multi_i2c<Scl, lanes<Sda...>, SA0, Counter> {
+    static_assert(sizeof...(Sda) >= 1 && sizeof...(Sda) <= 7, "");
+    static_assert((detail::same_port<Sda, Scl>() && ...),
+                  "all pins must be on the same port");
+
+    using counter_t = Counter;
+    using port = typename Scl::port_type;
+
+    static constexpr uint8_t nlanes{sizeof...(Sda)};
+    static constexpr uint8_t sda{(Sda::bv | ...)};
+    static constexpr uint8_t addr() { return 0b01111000 | SA0::bv; }
+
+    multi_i2c() = default;
+
+    explicit multi_i2c(Scl scl, Sda... sdas, SA0 = SA0{})
+    { detail::outputs(scl, sdas...); }
+
+    static void start_condition() {
+        Counter::start();
+        port::write(port::read() & ~sda);
+    }
+
+    static void send_slave_addr() {
+        Counter::addr_byte();
+        shift_out(addr());
+    }
+
+    static void send_ctrl_byte(dc mode, co co_bit = co::off) {
+        uint8_t byte{0x00};
+        if(co_bit == co::on) byte |= (1<<7);
+        if(mode == dc::data) byte |= (1<<6);
+        Counter::ctrl_byte();
+        shift_out(byte);
+    }
+
+    /** Sends the same byte to all panels. */
+    static void send_byte(uint8_t byte) {
+        Counter::payload_byte();
+        shift_out(byte);
+    }
+
+    /** Sends the byte bytes[i] to the panel of the lane 'i'. */
+    static void send_lanes(const uint8_t (&bytes)[sizeof...(Sda)]) {
+        Counter::payload_byte();
+        const uint8_t base = port::read() & ~(sda | Scl::bv);
+        port::write(base);
+        for(uint8_t mask{0x80}; mask; mask >>= 1) {
+            uint8_t i{0}, v{base};
+            ((v |= bytes[i++] & mask ? Sda::bv : 0), ...);
+            port::write(v);
+            port::write(v | Scl::bv);
+            port::write(v);
+        }
+        ack(base);
+    }
+
+    /** Sends the same byte to all panels. The byte isn't seen by the
+        counter. */
+    static void shift_out(uint8_t byte) {
+        const uint8_t base = port::read() & ~(sda | Scl::bv);
+        port::write(base);
+        for(uint8_t mask{0x80}; mask; mask >>= 1) {
+            uint8_t v = byte & mask ? base | sda : base;
+            port::write(v);
+            port::write(v | Scl::bv);
+            port::write(v);
+        }
+        ack(base);
+    }
+
+    static void stop_condition() {
+        Counter::stop();
+        uint8_t base = port::read() & ~sda;
+        port::write(base);
+        port::write(base | Scl::bv);
+        port::write(base | Scl::bv | sda);
+    }
+
+    static void start_commands() {
+        start_condition();
+        send_slave_addr();
+        send_ctrl_byte(dc::command);
+    }
+
+    static void start_data() {
+        start_condition();
+        send_slave_addr();
+        send_ctrl_byte(dc::data);
+    }
+
+private:
+    /** Acknowledge clock with all SDA lines released. */
+    static void ack(uint8_t base) {
+        port::write(base | sda);
+        port::write(base | sda | Scl::bv);
+        port::write(base | sda);
+    }
+};
+
+template<typename Scl, typename Lanes, typename SA0 = sa0::off_t,
+         typename Counter = no_counter, typename Window = window_cache>
+class multi_display;
+
+/** Display that draws on several panels at once using 'multi_i2c'
+
+    The operations of 'display' draw the same content on all panels.
+    out_lanes() draws a different content on each panel using the bus
+    time of one panel: the window is the same and the bytes of all
+    lanes are shifted together.
+
+    Scl, Lanes, SA0, Counter: take a look at 'multi_i2c'.
+    Window: take a look at 'display'.
+
+    Example:
+
+      multi_display<pb2_t, lanes<pb0_t, pb1_t>> disp{pb2, pb0, pb1};
+      const uint8_t* imgs[] = {left, right};
+      disp.out_lanes(page{0, 7}, column{0, 127}, imgs, 1024);
+*/
+template<typename Scl, typename... Sda, typename SA0, typename Counter,
+         typename Window>
+class multi_display<Scl, lanes<Sda...>, SA0, Counter, Window>
+    : public bus_display<multi_i2c<Scl, lanes<Sda...>, SA0, Counter>,
+                         Window>
+{
+public:
+    using bus_t = multi_i2c<Scl, lanes<Sda...>, SA0, Counter>;
+    static constexpr uint8_t nlanes{bus_t::nlanes};
+
+    multi_display() = default;
+
+    template<typename... Cmds>
+    multi_display(Scl scl, Sda... sdas, Cmds... cmds)
+        : bus_display<bus_t, Window>(bus_t(scl, sdas...), cmds...)
+    {}
+
+    /** Sends 'size' bytes to the window, the bytes of the lane 'i'
+        come from src[i] in RAM. */
+    void out_lanes(page pg, column col,
+                   const uint8_t* const (&src)[nlanes], uint16_t size)
+    {
+        out_lanes(pg, col, size, [&](uint8_t lane, uint16_t i)
+                  { return src[lane][i]; });
+    }
+
+    /** Sends 'size' bytes to the window, f(lane, i) returns the byte
+        'i' of the lane 'lane'. */
+    template<typename F>
+    void out_lanes(page pg, column col, uint16_t size, F&& f) {
+        auto& bus = this->device();
+        set(bus, pg, col);
+        bus.start_data();
+        uint8_t bytes[nlanes];
+        for(uint16_t i{0}; i < size; ++i) {
+            for(uint8_t l{0}; l < nlanes; ++l) bytes[l] = f(l, i);
+            bus.send_lanes(bytes);
+        }
+        bus.stop_condition();
+    }
+};
+
+}
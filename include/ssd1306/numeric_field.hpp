@@ -0,0 +1,118 @@
+#pragma once
+
+#include "ssd1306/decimal.hpp"
+#include "ssd1306/send_seven_segment.hpp"
+#include "ssd1306/set_page_column.hpp"
+
+#include <stdint.h>
+
+namespace ssd1306 {
+
+/** Unsigned number drawn with seven segment digits that redraws only
+    the digits that were changed
+
+    The field remembers the digits of the last value. update() sends
+    only the cells whose digit is different, a run of adjacent changed
+    cells is sent using one window and one data transaction. When the
+    new value has less digits than the previous one, the trailing
+    cells are cleared.
+
+    The number is left aligned at the page and column given to the
+    constructor, each cell has 'w + spacing' columns and 'h / 8'
+    pages. The cells are clamped to the screen: a cell that doesn't
+    fit before the column 127 isn't drawn, because its window would
+    wrap to the first column of the field.
+
+    w, h, spacing: take a look at 'send_digit_segmented()'.
+    MaxDigits: maximum number of digits, 3 to 8 bits, 5 to 16 bits
+               and 10 to 32 bits. update() doesn't compile with a type
+               that can have more digits than 'MaxDigits'.
+
+    precondition: the device is using the vertical addressing mode.
+
+    Example:
+
+      numeric_field<20, 32, 5, 5> counter{page{0}, column{0}};
+      uint16_t n{0};
+      while(true) counter.update(disp.device(), ++n);
+*/
+template<uint8_t w, uint8_t h, uint8_t spacing = 5, uint8_t MaxDigits = 10>
+class numeric_field {
+    static_assert(MaxDigits >= 1 && MaxDigits <= 10, "");
+    static constexpr uint8_t pages{h / 8};
+    static constexpr uint8_t cell{w + spacing};
+    uint8_t _page, _col;
+    uint8_t _fit;
+    uint8_t _digits[MaxDigits];
+    uint8_t _n{0};
+
+    template<typename Dev>
+    void send_run(Dev&& dev, const uint8_t (&digits)[MaxDigits], uint8_t n,
+                  uint8_t first, uint8_t last)
+    {
+        if(first >= _fit) return;
+        if(last >= _fit) last = _fit - 1;
+        set(dev, page{_page, uint8_t(_page + pages - 1)},
+            column{uint8_t(_col + first * cell),
+                   uint8_t(_col + (last + 1) * cell - 1)});
+        dev.start_data();
+        for(uint8_t i{first}; i <= last; ++i) {
+            if(i < n) send_digit<w, h, spacing>(dev, digits[i]);
+            else send_digit_segmented<w, h, spacing>(dev, 0);
+        }
+        dev.stop_condition();
+    }
+public:
+    /** Only the start of 'pg' and 'col' are used. */
+    numeric_field(page pg, column col)
+        : _page(pg.start)
+        , _col(col.start)
+        , _fit((128 - col.start) / cell < MaxDigits
+               ? (128 - col.start) / cell : MaxDigits)
+    {}
+
+    /** Number of digits of the last value. */
+    uint8_t size() const { return _n; }
+
+    /** Forces the next update to redraw all digits. */
+    void invalidate() {
+        for(uint8_t i{}; i < _n; ++i) _digits[i] = digit_blank;
+    }
+
+    /** Draws 'v' sending only the changed cells. Returns the number
+        of digits of 'v'.
+
+        UInt: integer type with 8, 16 or 32 bits, which selects the
+              conversion of 'for_each_digit()'. The value of a signed
+              type must not be negative.
+    */
+    template<typename Dev, typename UInt>
+    uint8_t update(Dev&& dev, UInt v) {
+        static_assert(sizeof(UInt) <= 4, "the value has more than 32 bits");
+        static_assert(MaxDigits >= (sizeof(UInt) == 1 ? 3
+                                    : sizeof(UInt) == 2 ? 5 : 10),
+                      "the value can have more digits than MaxDigits");
+        uint8_t digits[MaxDigits];
+        uint8_t n{0};
+        auto store = [&](uint8_t d){ digits[n++] = d; };
+        if constexpr(sizeof(UInt) == 1) for_each_digit(uint8_t(v), store);
+        else if constexpr(sizeof(UInt) == 2)
+            for_each_digit(uint16_t(v), store);
+        else for_each_digit(uint32_t(v), store);
+        uint8_t cells = n > _n ? n : _n;
+        for(uint8_t i{0}; i < cells;) {
+            auto changed = [&](uint8_t j)
+            { return j >= n || j >= _n || digits[j] != _digits[j]; };
+            if(!changed(i)) { ++i; continue; }
+            uint8_t first{i};
+            while(i + 1 < cells && changed(i + 1)) ++i;
+            send_run(dev, digits, n, first, i);
+            ++i;
+        }
+        for(uint8_t i{0}; i < n; ++i) _digits[i] = digits[i];
+        _n = n;
+        return n;
+    }
+};
+
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "ssd1306/detail/progmem.hpp"
+
+#include <stdint.h>
+
+namespace ssd1306 {
+
+/** Image compressed with PackBits in the program memory
+
+    The compressed bytes are a sequence of packets, each one starts
+    with a header byte 'h':
+
+    - h in [0, 127]: literal run, the next 'h + 1' bytes are copied;
+    - h in [129, 255]: repeated run, the next byte is repeated
+      '257 - h' times;
+    - h == 128: isn't used.
+
+    raw_size: number of bytes of the image after the decompression.
+*/
+struct packed_bytes {
+    const uint8_t* bytes;
+    uint16_t size;
+    uint16_t raw_size;
+};
+
+namespace detail {
+
+//Length of the run of equal bytes at 'i', limited to 128.
+template<typename In>
+constexpr uint8_t run_length(const In& in, uint16_t n, uint16_t i) {
+    uint8_t len{1};
+    while(i + len < n && len < 128 && in[i + len] == in[i]) ++len;
+    return len;
+}
+
+/** Compresses 'n' bytes of 'in' calling out(pos, byte) to each byte
+    of the result. Returns the size of the result. 'in' is a pointer or
+    any type with 'in[i]'.
+
+    A run of two or more equal bytes is a repeated run when it starts
+    a packet. A literal run is broken only by a run of three or more
+    equal bytes, because a run of two costs the same in both kinds of
+    packet.
+*/
+template<typename In, typename Out>
+constexpr uint16_t packbits_encode(const In& in, uint16_t n, Out out) {
+    uint16_t pos{0};
+    for(uint16_t i{0}; i < n;) {
+        uint8_t run = run_length(in, n, i);
+        if(run >= 2) {
+            out(pos++, uint8_t(257 - run));
+            out(pos++, in[i]);
+            i += run;
+            continue;
+        }
+        uint16_t j{i};
+        while(j < n && j - i < 128 && run_length(in, n, j) < 3) ++j;
+        out(pos++, uint8_t(j - i - 1));
+        for(; i < j; ++i) out(pos++, in[i]);
+    }
+    return pos;
+}
+
+/** Decompresses the packets at 'p' that have 'raw_size' bytes after
+    the decompression, take a look at 'for_each_packet()'. Returns the
+    end of the packets. */
+template<typename Literal, typename Run>
+inline const uint8_t* decode_packets(const uint8_t* p, uint16_t raw_size,
+                                     Literal&& literal, Run&& run)
+{
+    while(raw_size) {
+        uint8_t h = detail::read_flash(p++);
+        if(h < 128) {
+            literal(p, uint8_t(h + 1));
+            p += h + 1;
+            raw_size -= h + 1;
+        } else if(h > 128) {
+            run(detail::read_flash(p++), uint8_t(257 - h));
+            raw_size -= 257 - h;
+        }
+    }
+    return p;
+}
+
+} //namespace detail
+
+/** Image compressed at compile time with PackBits
+
+    Image: constexpr array with static storage with the bytes of the
+           image in the order of the GDDRAM writes, for example, 1024
+           bytes of a whole screen in the vertical addressing mode.
+           The array is only read by the compiler, only the
+           compressed bytes are placed in the flash.
+
+    Example:
+
+      constexpr uint8_t splash[1024] = {...};
+      disp.out(page{0, 7}, column{0, 127}, packbits<splash>::span());
+*/
+template<const auto& Image>
+struct packbits {
+    static_assert(sizeof(Image) <= 0xffff, "the image is too large");
+    static constexpr uint16_t raw_size{uint16_t(sizeof(Image))};
+
+    static constexpr uint16_t size
+    {detail::packbits_encode(Image, raw_size, [](uint16_t, uint8_t){})};
+
+    struct bytes_t { uint8_t value[size]; };
+
+    static constexpr bytes_t make() {
+        bytes_t r{};
+        detail::packbits_encode(Image, raw_size, [&](uint16_t i, uint8_t b)
+                                { r.value[i] = b; });
+        return r;
+    }
+
+    static const bytes_t bytes;
+
+    static packed_bytes span() { return {bytes.value, size, raw_size}; }
+};
+
+template<const auto& Image>
+const typename packbits<Image>::bytes_t packbits<Image>::bytes
+SSD1306_PROGMEM = packbits<Image>::make();
+
+/** Decompresses 'src' calling literal(p, n) to each literal run of
+    'n' bytes at 'p' in the flash and run(byte, n) to each repeated
+    run. */
+template<typename Literal, typename Run>
+inline void for_each_packet(packed_bytes src, Literal&& literal, Run&& run)
+{ detail::decode_packets(src.bytes, src.raw_size, literal, run); }
+
+namespace detail {
+
+/** Sends the packets at 'p' that have 'raw_size' bytes after the
+    decompression. Returns the end of the packets. */
+template<typename Bus>
+inline const uint8_t* send_packets(Bus& bus, const uint8_t* p,
+                                   uint16_t raw_size)
+{
+    return decode_packets(p, raw_size,
+        [&](const uint8_t* q, uint8_t n)
+        { for(; n; --n, ++q) bus.send_byte(read_flash(q)); },
+        [&](uint8_t byte, uint8_t n)
+        { for(; n; --n) bus.send_byte(byte); });
+}
+
+} //namespace detail
+
+/** Sends the decompressed bytes of 'src' to the bus, which should be
+    in a data transaction. A repeated run reads the flash once. */
+template<typename Bus>
+inline void send_packed(Bus&& bus, packed_bytes src)
+{ detail::send_packets(bus, src.bytes, src.raw_size); }
+
+}
@@ -0,0 +1,209 @@
+#pragma once
+
+#include "ssd1306/async_bus.hpp"
+#include "ssd1306/set_page_column.hpp"
+#include "ssd1306/sliced_renderer.hpp"
+
+#include <stdint.h>
+
+namespace ssd1306 {
+
+/** Region of a panel that should be redrawn by 'panel_scheduler'
+
+    src: data bytes of the region, a 'transfer' from ram(), flash()
+         or fill() with the size of the region.
+    priority: the greater, the sooner.
+    timed, deadline: if 'timed' is true, the update should be sent
+                     before the tick 'deadline' of the clock passed
+                     to step().
+*/
+struct panel_update {
+    page pg;
+    column col;
+    transfer src;
+    uint8_t priority{0};
+    bool timed{false};
+    uint16_t deadline{0};
+
+    /** True if the region of 'o' is inside of this one. */
+    bool covers(const panel_update& o) const {
+        return pg.start <= o.pg.start && pg.end >= o.pg.end
+            && col.start <= o.col.start && col.end >= o.col.end;
+    }
+};
+
+namespace detail {
+
+//True if the tick 'a' is before or equal to 'b'. The clock wraps.
+inline bool not_after(uint16_t a, uint16_t b)
+{ return int16_t(b - a) >= 0; }
+
+/** Queue of updates of one panel, they are sent in the order of
+    arrival by a 'sliced_renderer'. The first one is being sent when
+    the renderer is busy. */
+template<typename Bus, uint8_t Capacity>
+class panel_queue {
+    sliced_renderer<Bus> _r;
+    panel_update _q[Capacity];
+    uint8_t _n{0};
+
+    void erase(uint8_t i) {
+        --_n;
+        for(; i < _n; ++i) _q[i] = _q[i + 1];
+    }
+public:
+    uint8_t age{0};
+
+    bool empty() const { return !_n; }
+
+    uint8_t size() const { return _n; }
+
+    /** Enqueues 'u'. The pending updates whose regions are covered by
+        'u' are dropped, 'u' inherits their greatest priority and
+        their earliest deadline. Returns false if the queue is full. */
+    bool push(panel_update u) {
+        uint8_t first = _r.busy() ? 1 : 0;
+        for(uint8_t i{first}; i < _n;) {
+            if(!u.covers(_q[i])) { ++i; continue; }
+            const auto& o = _q[i];
+            if(o.priority > u.priority) u.priority = o.priority;
+            if(o.timed && (!u.timed || !not_after(u.deadline, o.deadline))) {
+                u.timed = true;
+                u.deadline = o.deadline;
+            }
+            erase(i);
+        }
+        if(_n == Capacity) return false;
+        _q[_n++] = u;
+        return true;
+    }
+
+    /** Greatest priority of the queue. */
+    uint8_t priority() const {
+        uint8_t p{0};
+        for(uint8_t i{0}; i < _n; ++i)
+            if(_q[i].priority > p) p = _q[i].priority;
+        return p;
+    }
+
+    /** Earliest deadline of the queue, returns false if there isn't
+        one. */
+    bool deadline(uint16_t& d) const {
+        bool found{false};
+        for(uint8_t i{0}; i < _n; ++i)
+            if(_q[i].timed && (!found || not_after(_q[i].deadline, d))) {
+                d = _q[i].deadline;
+                found = true;
+            }
+        return found;
+    }
+
+    /** Sends at most 'max_bytes' bytes of the first update. */
+    void step(uint16_t max_bytes) {
+        if(!_n) return;
+        if(!_r.busy()) _r.region(_q[0].pg, _q[0].col, _q[0].src);
+        if(!_r.step(max_bytes)) erase(0);
+    }
+};
+
+} //namespace detail
+
+/** Scheduler of the updates of two panels on the same I2C bus
+
+    The SSD1306 has two slave addresses(SA0), so two panels can share
+    SDA and SCL. Each panel has a queue of dirty regions and step()
+    sends a chunk of at most 'max_bytes' bytes of one of them, the
+    transactions are closed between the chunks, so the panels are
+    interleaved on the bus. The panel of each chunk is chosen by:
+
+    1. the earliest deadline that expires up to the end of the chunk:
+       the current tick plus 'chunk_ticks', the ticks that a chunk of
+       'max_bytes' bytes takes on the bus;
+    2. the greatest priority plus the number of chunks that the panel
+       waited(aging), so a panel with lower priority isn't starved by
+       a panel that redraws all the time;
+    3. the panel that wasn't served by the last chunk.
+
+    An update that covers the region of a pending update of the same
+    panel replaces it before it reaches the bus.
+
+    Bus0, Bus1: transports of the panels, for example,
+                'i2c<pb0_t, pb2_t, sa0::off_t>' and
+                'i2c<pb0_t, pb2_t, sa0::on_t>'.
+    Capacity: maximum number of pending updates of each panel.
+
+    precondition: both panels are using the vertical addressing mode.
+
+    Example:
+
+      panel_scheduler<i2c<pb0_t, pb2_t, sa0::off_t>,
+                      i2c<pb0_t, pb2_t, sa0::on_t>> s;
+      s.push(0, {page{0, 7}, column{0, 127},
+                 transfer::flash(dc::data, chart, 1024)});
+      s.push(1, {page{0, 1}, column{0, 63},
+                 transfer::ram(dc::data, label, 128), 1});
+      //a chunk of 32 bytes takes about 3 ticks of 1ms at 100kHz
+      while(s.step(ticks(), 32, 3)) control_loop();
+*/
+template<typename Bus0, typename Bus1, uint8_t Capacity = 4>
+class panel_scheduler {
+    detail::panel_queue<Bus0, Capacity> _p0;
+    detail::panel_queue<Bus1, Capacity> _p1;
+    uint8_t _last{1};
+
+    /** Returns -1 if the panel 0 should be served before the panel
+        1, 1 if the panel 1 should be served before the panel 0, or 0
+        if the criteria don't decide. */
+    template<typename P0, typename P1>
+    static int8_t compare(const P0& p0, const P1& p1, uint16_t horizon) {
+        uint16_t d0{0}, d1{0};
+        bool u0 = p0.deadline(d0) && detail::not_after(d0, horizon);
+        bool u1 = p1.deadline(d1) && detail::not_after(d1, horizon);
+        if(u0 != u1) return u0 ? -1 : 1;
+        if(u0 && d0 != d1) return detail::not_after(d0, d1) ? -1 : 1;
+        uint16_t s0 = p0.priority() + p0.age, s1 = p1.priority() + p1.age;
+        if(s0 != s1) return s0 > s1 ? -1 : 1;
+        return 0;
+    }
+public:
+    static constexpr uint8_t capacity{Capacity};
+
+    /** Enqueues an update to the panel 0 or 1. Returns false if the
+        queue of the panel is full. */
+    bool push(uint8_t panel, const panel_update& u)
+    { return panel ? _p1.push(u) : _p0.push(u); }
+
+    /** Number of pending updates of a panel. */
+    uint8_t pending(uint8_t panel) const
+    { return panel ? _p1.size() : _p0.size(); }
+
+    bool idle() const { return _p0.empty() && _p1.empty(); }
+
+    /** Sends one chunk of at most 'max_bytes' bytes. 'now' is the
+        current tick of the clock of the deadlines and 'chunk_ticks'
+        is the number of ticks of that clock that a chunk takes.
+        Returns true if there is more to send. */
+    bool step(uint16_t now, uint16_t max_bytes, uint16_t chunk_ticks) {
+        if(idle()) return false;
+        uint8_t panel;
+        if(_p0.empty()) panel = 1;
+        else if(_p1.empty()) panel = 0;
+        else {
+            auto c = compare(_p0, _p1, uint16_t(now + chunk_ticks));
+            panel = c ? (c > 0) : !_last;
+        }
+        if(panel) {
+            _p1.step(max_bytes);
+            _p1.age = 0;
+            if(!_p0.empty() && _p0.age < 0xff) ++_p0.age;
+        } else {
+            _p0.step(max_bytes);
+            _p0.age = 0;
+            if(!_p1.empty() && _p1.age < 0xff) ++_p1.age;
+        }
+        _last = panel;
+        return !idle();
+    }
+};
+
+}
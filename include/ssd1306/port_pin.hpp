@@ -0,0 +1,53 @@
+#pragma once
+
+#include "ssd1306/mmio.hpp"
+
+#include <stdint.h>
+
+namespace ssd1306 {
+
+/** PORT register of a port, which is read and written as a whole
+
+    Port: addresses of the registers of the port, for example,
+          'atmega328p_portb'.
+    Regs: register policy, take a look at 'ssd1306/mmio.hpp'.
+*/
+template<typename Port, typename Regs = mmio>
+struct port_register {
+    static uint8_t read() { return Regs::read(Port::port); }
+    static void write(uint8_t v) { Regs::write(Port::port, v); }
+};
+
+/** Digital output pin that declares its port
+
+    It offers the operations of the pins of avrIO that are used by
+    'i2c' plus 'port_type', the PORT register of the pin, and 'bv',
+    its bit mask. 'i2c' uses them to write SDA and SCL together when
+    both pins are on the same port, take a look at
+    'detail::shift_out_same_port()'.
+
+    Port: addresses of the registers of the port, for example,
+          'atmega328p_portb'.
+    Bit: bit number inside of the port [0, 7]
+    Regs: register policy, take a look at 'ssd1306/mmio.hpp'.
+
+    Example:
+
+      using sda = port_pin<attiny85_portb, 0>;
+      using scl = port_pin<attiny85_portb, 2>;
+      display<sda, scl> disp{sda{}, scl{}};
+*/
+template<typename Port, uint8_t Bit, typename Regs = mmio>
+struct port_pin {
+    static_assert(Bit < 8, "");
+    using port_type = port_register<Port, Regs>;
+    static constexpr uint8_t bv{1<<Bit};
+
+    static void out() { Regs::write(Port::ddr, Regs::read(Port::ddr) | bv); }
+    static void high() { port_type::write(port_type::read() | bv); }
+    static void low() { port_type::write(port_type::read() & ~bv); }
+    static void pulse() { high(); low(); }
+    static bool is_high() { return Regs::read(Port::pin) & bv; }
+};
+
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "ssd1306/detail/merge_cmds.hpp"
+#include "ssd1306/detail/progmem.hpp"
 #include "ssd1306/i2c.hpp"
 
 #include <stdint.h>
@@ -14,4 +16,53 @@ void send_commands(I2C&& dev, const T(&cmds)[N]) {
     dev.stop_condition();
 }
 
+namespace detail {
+
+template<typename Merged, typename I2C>
+inline void send_merged(I2C& dev) {
+    if(Merged::size == 0) return;
+    dev.start_commands();
+    for(uint8_t i{0}; i < Merged::size; ++i)
+        dev.send_byte(read_flash(&Merged::value.data[i]));
+    dev.stop_condition();
+}
+
+} //namespace detail
+
+/** Sends a sequence of commands from 'ssd1306/commands.hpp' using
+    one transaction
+
+    The bytes of the commands are concatenated at compile time and
+    they are read from the flash. All commands are sent in the order
+    that they are given.
+
+    Example:
+
+      send_commands(dev, contrast<0xff>{}, turn_off{});
+*/
+template<typename I2C, typename... Cmds>
+void send_commands(I2C&& dev, Cmds...)
+{ detail::send_merged<detail::merged_commands<false, Cmds...>>(dev); }
+
+/** Sends a sequence of commands assuming that the controller is in
+    the reset state
+
+    It's like 'send_commands()', but the commands that repeat the
+    reset value of a setting, or that are replaced by a later command
+    of the same kind, are dropped. Nothing is sent if all commands are
+    dropped. The display constructors use it.
+
+    precondition: the controller is in the reset state, which is true
+    after the power on. Use 'always<Cmd>' to send a command regardless
+    of this assumption.
+
+    Example:
+
+      //sends only 0xAF, the other ones are reset values
+      send_commands_from_reset(dev, contrast<0x7f>{}, turn_on{});
+*/
+template<typename I2C, typename... Cmds>
+void send_commands_from_reset(I2C&& dev, Cmds...)
+{ detail::send_merged<detail::merged_commands<true, Cmds...>>(dev); }
+
 }
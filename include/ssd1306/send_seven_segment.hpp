@@ -1,5 +1,7 @@
 #pragma once
 
+#include "ssd1306/decimal.hpp"
+#include "ssd1306/detail/progmem.hpp"
 #include "ssd1306/i2c.hpp"
 
 #include <stdint.h>
@@ -91,102 +93,166 @@ constexpr static auto o = seven_segment
 } //namespace segments
 
 namespace detail {
-template<int pages, typename I2C>
-inline void draw_column(I2C&& i2c, uint8_t b) {
-    for(uint8_t i{}; i < pages / 2; ++i)
-        i2c.send_byte(b);
+
+/** Column patterns of a seven segment digit with 'pages' pages
+
+    A digit has three kinds of columns: the two ones of the left edge,
+    the ones of the middle and the two ones of the right edge. The
+    edges depend only on two segments and the middle on three, so all
+    the columns of all digits are in 12 patterns:
+
+    edge[i]: i = bit0(top segment) | bit1(bottom segment)
+    middle[i]: i = bit0(top) | bit1(middle) | bit2(bottom)
+*/
+template<uint8_t pages>
+struct seven_segment_columns_t {
+    uint8_t edge[4][pages];
+    uint8_t middle[8][pages];
+};
+
+template<uint8_t pages>
+constexpr seven_segment_columns_t<pages> make_seven_segment_columns() {
+    seven_segment_columns_t<pages> ret{};
+    for(uint8_t i{}; i < 4; ++i)
+        for(uint8_t p{}; p < pages; ++p)
+            ret.edge[i][p] = (p < pages / 2 ? i & 1 : i & 2) ? 0xff : 0x00;
+    for(uint8_t i{}; i < 8; ++i) {
+        bool top = i & 1, middle = i & 2, bottom = i & 4;
+        auto& col = ret.middle[i];
+        col[0] = top ? 0x03 : 0x00;
+        col[pages - 1] = bottom ? 0xc0 : 0x00;
+        if(middle) {
+            col[pages / 2 - 1] |= 0x80;
+            col[pages / 2] |= 0x01;
+        }
+    }
+    return ret;
 }
+
+template<uint8_t pages>
+struct seven_segment_columns {
+    static const seven_segment_columns_t<pages> value;
+};
+
+template<uint8_t pages>
+const seven_segment_columns_t<pages> seven_segment_columns<pages>::value
+SSD1306_PROGMEM = make_seven_segment_columns<pages>();
+
+/** Segments of the digits from 0 to 9. */
+template<typename = void>
+struct digit_segments {
+    static const uint8_t value[10];
+};
+
+template<typename T>
+const uint8_t digit_segments<T>::value[10] SSD1306_PROGMEM = {
+    segments::_0.segments, segments::_1.segments, segments::_2.segments,
+    segments::_3.segments, segments::_4.segments, segments::_5.segments,
+    segments::_6.segments, segments::_7.segments, segments::_8.segments,
+    segments::_9.segments
+};
+
+/** Column patterns of the three kinds of columns of a digit. */
+struct digit_columns {
+    const uint8_t *left, *middle, *right;
+};
+
+/** Selects the patterns of the digit with the segments 's' from the
+    patterns 'edge' and 'middle' of a 'seven_segment_columns_t' with
+    'pages' pages. */
+inline digit_columns select_columns(const uint8_t* edge,
+                                    const uint8_t* middle, uint8_t pages,
+                                    uint8_t s)
+{
+    using namespace segment;
+    return {edge + pages * ((s & left_top ? 1 : 0)
+                            | (s & left_bottom ? 2 : 0)),
+            middle + pages * ((s & top ? 1 : 0)
+                              | (s & segment::middle ? 2 : 0)
+                              | (s & bottom ? 4 : 0)),
+            edge + pages * ((s & right_top ? 1 : 0)
+                            | (s & right_bottom ? 2 : 0))};
+}
+
+template<uint8_t pages, typename I2C>
+inline void send_column(I2C&& i2c, const uint8_t* col) {
+    for(uint8_t i{}; i < pages; ++i)
+        i2c.send_byte(read_flash(col + i));
+}
+
 } //namespace detail
 
+/** Sends a seven segment digit with 'width' columns and 'height'
+    rows followed by 'spacing' empty columns
+
+    The columns are streamed from patterns that are computed at
+    compile time and stored in the flash, take a look at
+    'detail::seven_segment_columns_t'. The segments select one pattern
+    to each kind of column and there isn't any branch inside of the
+    loops.
+*/
 template<uint8_t width, uint8_t height, uint8_t spacing = 3, typename I2C>
 void send_digit_segmented(I2C&& i2c, uint8_t segments) {
-    using namespace segment;
     static_assert(width >= 12 && width <= 64);
     static_assert(height % 16 == 0);
     static_assert(height >= 16 && height <= 64);
     constexpr auto pages = height / 8;
-    for(uint8_t col{0}; col < width; ++col) {
-        if(col < 2) {
-            if(segments & left_top) detail::draw_column<pages>(i2c, 0xff);
-            else detail::draw_column<pages>(i2c, 0x00);
-            if(segments & left_bottom) detail::draw_column<pages>(i2c, 0xff);
-            else detail::draw_column<pages>(i2c, 0x00);
-        } else if(col >= 2 && col < (width - 2)) {
-            if(pages == 2) {
-                if(segments & top) {
-                    if(segments & middle) i2c.send_byte(0x83);
-                    else i2c.send_byte(0x03);
-                } else {
-                    if(segments & middle) i2c.send_byte(0x80);
-                    else i2c.send_byte(0x00);
-                }
-                if(segments & bottom) {
-                    if(segments & middle) i2c.send_byte(0xc1);
-                    else i2c.send_byte(0xc0);
-                } else {
-                    if(segments & middle) i2c.send_byte(0x01);
-                    else i2c.send_byte(0x00);
-                }
-            } else {
-                if(segments & top) i2c.send_byte(0x03);
-                else i2c.send_byte(0x00);
-                if(segments & middle) {
-                    detail::draw_column<pages - 4>(i2c, 0x00);
-                    i2c.send_byte(0x80);
-                    i2c.send_byte(0x01);
-                } else detail::draw_column<pages>(i2c, 0x00);
-                detail::draw_column<pages - 4>(i2c, 0x00);
-                if(segments & bottom) i2c.send_byte(0xc0);
-                else i2c.send_byte(0x00);
-            }
-        } else if(col >= (width - 2) && col < width) {
-            if(segments & right_top) detail::draw_column<pages>(i2c, 0xff);
-            else detail::draw_column<pages>(i2c, 0x00);
-            if(segments & right_bottom) detail::draw_column<pages>(i2c, 0xff);
-            else detail::draw_column<pages>(i2c, 0x00);
-        }
-    }
+    const auto& cols = detail::seven_segment_columns<pages>::value;
+    auto c = detail::select_columns(&cols.edge[0][0], &cols.middle[0][0],
+                                    pages, segments);
+    detail::send_column<pages>(i2c, c.left);
+    detail::send_column<pages>(i2c, c.left);
+    for(uint8_t col{2}; col < width - 2; ++col)
+        detail::send_column<pages>(i2c, c.middle);
+    detail::send_column<pages>(i2c, c.right);
+    detail::send_column<pages>(i2c, c.right);
     for(uint8_t i{}; i < spacing * pages; ++i)
         i2c.send_byte(0x00);
 }
 
+/** Sends the digit 'i', the values greater than 9 are sent as 9. */
 template<uint8_t width, uint8_t height, uint8_t spacing, typename I2C> 
 void send_digit(I2C&& dev, uint8_t i) {
-    using namespace segment;
-    
-    seven_segment digit;
-    if(i == 0) digit = segments::_0;
-    else if(i == 1) digit = segments::_1;
-    else if(i == 2) digit = segments::_2;
-    else if(i == 3) digit = segments::_3;
-    else if(i == 4) digit = segments::_4;
-    else if(i == 5) digit = segments::_5;
-    else if(i == 6) digit = segments::_6;
-    else if(i == 7) digit = segments::_7;
-    else if(i == 8) digit = segments::_8;
-    else  digit = segments::_9;
-    
-    send_digit_segmented<width, height, spacing>(dev, digit.segments);
+    if(i > 9) i = 9;
+    send_digit_segmented<width, height, spacing>
+        (dev, detail::read_flash(&detail::digit_segments<>::value[i]));
 }
 
-template<uint8_t w, uint8_t h, uint8_t spacing = 5, typename I2C> 
-uint8_t send_int(I2C&& dev, uint8_t i) {
-    if(i < 10) {
-        send_digit<w, h, spacing>(dev, i);
-        return 1;
-    }
-    auto d = send_int<w, h, spacing>(dev, uint8_t(i / 10));
-    return send_int<w, h, spacing>(dev, uint8_t(i % 10)) + d;
+namespace detail {
+
+template<uint8_t w, uint8_t h, uint8_t spacing, typename I2C, typename UInt>
+inline uint8_t send_int(I2C&& dev, UInt i, uint8_t width) {
+    return for_each_digit(i, [&](uint8_t d){
+        if(d == digit_blank)
+            send_digit_segmented<w, h, spacing>(dev, 0);
+        else send_digit<w, h, spacing>(dev, d);
+    }, width);
 }
 
+} //namespace detail
+
+/** Sends the decimal representation of an unsigned integer
+
+    width: minimum number of digits. The number is right aligned and
+           the positions at the left of it are blank digits. The
+           default value 0 sends only the digits of the number.
+
+    Returns the number of digits that were sent, including the blank
+    ones.
+
+    The conversion doesn't use division, take a look at
+    'ssd1306/decimal.hpp'.
+*/
 template<uint8_t w, uint8_t h, uint8_t spacing = 5, typename I2C> 
-uint8_t send_int(I2C&& dev, uint32_t i) {
-    if(i < 10) {
-        send_digit<w, h, spacing>(dev, i);
-        return 1;
-    }
-    auto d = send_int<w, h, spacing>(dev, i / 10);
-    return send_int<w, h, spacing>(dev, i % 10) + d;
-}
+uint8_t send_int(I2C&& dev, uint8_t i, uint8_t width = 0)
+{ return detail::send_int<w, h, spacing>(dev, i, width); }
+
+template<uint8_t w, uint8_t h, uint8_t spacing = 5, typename I2C> 
+uint8_t send_int(I2C&& dev, uint16_t i, uint8_t width = 0)
+{ return detail::send_int<w, h, spacing>(dev, i, width); }
+
+template<uint8_t w, uint8_t h, uint8_t spacing = 5, typename I2C> 
+uint8_t send_int(I2C&& dev, uint32_t i, uint8_t width = 0)
+{ return detail::send_int<w, h, spacing>(dev, i, width); }
 
 }
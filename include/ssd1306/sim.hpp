@@ -0,0 +1,11 @@
+#pragma once
+
+#include "ssd1306/sim/board.hpp"
+#include "ssd1306/sim/controller.hpp"
+#include "ssd1306/sim/i2c_peripherals.hpp"
+#include "ssd1306/sim/i2c_decoder.hpp"
+#include "ssd1306/sim/memory.hpp"
+#include "ssd1306/sim/registers.hpp"
+#include "ssd1306/sim/timer.hpp"
+#include "ssd1306/sim/virtual_display.hpp"
+#include "ssd1306/sim/virtual_spi_display.hpp"
@@ -0,0 +1,15 @@
+#pragma once
+
+// Host replacement of the header <avr/io.hpp> from avrIO. It's used
+// when the library is compiled to run with the mock pins of
+// 'ssd1306::sim', for example:
+//
+//   g++ -std=c++17 -Iinclude -Iinclude/ssd1306/sim demo.cpp
+
+namespace avr { namespace io {
+
+// The mock pins are always outputs.
+template<typename... Pins>
+inline void out(Pins...) {}
+
+}}
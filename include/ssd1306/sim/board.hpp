@@ -0,0 +1,130 @@
+#pragma once
+
+#include "ssd1306/detail/global.hpp"
+
+#include <stdint.h>
+#include <functional>
+#include <vector>
+
+namespace ssd1306 { namespace sim {
+
+/** Host model of the MCU I/O ports
+
+    Each port is a byte of logical levels, one bit for each pin. All
+    pins start released(HIGH), which models the pull-up resistors of
+    the I2C bus.
+
+    Observers are notified after each write that changes the level of
+    at least one pin. Two or more pins that are changed by one write
+    are seen as changed at the same instant, like the real hardware
+    does when a whole port register is written.
+*/
+class board {
+    static constexpr uint8_t nports{4};
+    uint8_t _levels[nports];
+    uint32_t _writes{0};
+    std::vector<std::function<void()>> _observers;
+
+    board() { reset(); }
+public:
+    static board& instance() {
+        static board o;
+        return o;
+    }
+
+    /** Releases all pins to HIGH. Observers are kept. */
+    void reset() {
+        for(auto& l : _levels) l = 0xff;
+    }
+
+    uint8_t read(uint8_t port) const { return _levels[port]; }
+
+    bool level(uint8_t port, uint8_t bit) const
+    { return _levels[port] & (1<<bit); }
+
+    /** Writes the bits selected by 'mask' using the values in 'v'. */
+    void write(uint8_t port, uint8_t v, uint8_t mask = 0xff) {
+        ++_writes;
+        uint8_t n = (_levels[port] & ~mask) | (v & mask);
+        if(n == _levels[port]) return;
+        _levels[port] = n;
+        for(auto& o : _observers) o();
+    }
+
+    /** Number of writes to the ports, including the ones that don't
+        change any level. Each one models one access to a PORT
+        register. */
+    uint32_t writes() const { return _writes; }
+
+    /** Registers a callback and returns a handle to remove it. */
+    std::size_t observe(std::function<void()> f) {
+        _observers.push_back(std::move(f));
+        return _observers.size() - 1;
+    }
+
+    void forget(std::size_t handle)
+    { _observers[handle] = []{}; }
+};
+
+/** PORT register of a port of the 'board'
+
+    It allows the driver to write all pins of a port at once, like
+    'ssd1306::port_register' does on the MCU.
+*/
+template<uint8_t Port>
+struct port_register {
+    static uint8_t read() { return board::instance().read(Port); }
+    static void write(uint8_t v) { board::instance().write(Port, v); }
+};
+
+/** Mock of a digital output pin of avrIO
+
+    It offers the subset of the pin interface of avrIO that is used by
+    'ssd1306::i2c': low(), high() and pulse(). Like the pins of avrIO,
+    it doesn't declare its port, so 'i2c' writes SDA and SCL one at a
+    time even if both are on the same port.
+
+    Port: index of the port [0, 3]
+    Bit: bit number inside of the port [0, 7]
+*/
+template<uint8_t Port, uint8_t Bit>
+struct plain_pin {
+    static_assert(Port < 4 && Bit < 8, "");
+    static constexpr uint8_t port{Port};
+    static constexpr uint8_t bit{Bit};
+    static constexpr uint8_t bv{1<<Bit};
+
+    static void high() { board::instance().write(Port, bv, bv); }
+    static void low() { board::instance().write(Port, 0x00, bv); }
+    static void pulse() { high(); low(); }
+    static void toggle()
+    { board::instance().write(Port, ~board::instance().read(Port), bv); }
+    static bool is_high() { return board::instance().level(Port, Bit); }
+};
+
+/** Mock of a digital output pin that declares its port, like
+    'ssd1306::port_pin'
+
+    'port_type' and 'bv' allow 'i2c' to write two pins of the same
+    port at once, take a look at 'detail::shift_out_same_port()'.
+*/
+template<uint8_t Port, uint8_t Bit>
+struct pin : plain_pin<Port, Bit> {
+    using port_type = port_register<Port>;
+};
+
+using pb0_t = pin<1, 0>;
+using pb1_t = pin<1, 1>;
+using pb2_t = pin<1, 2>;
+using pb3_t = pin<1, 3>;
+using pb4_t = pin<1, 4>;
+using pb5_t = pin<1, 5>;
+
+SSD1306_INLINE_GLOBAL(pb0)
+SSD1306_INLINE_GLOBAL(pb1)
+SSD1306_INLINE_GLOBAL(pb2)
+SSD1306_INLINE_GLOBAL(pb3)
+SSD1306_INLINE_GLOBAL(pb4)
+SSD1306_INLINE_GLOBAL(pb5)
+
+}}
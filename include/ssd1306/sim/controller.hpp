@@ -0,0 +1,189 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+namespace ssd1306 { namespace sim {
+
+enum class addressing { horizontal = 0, vertical = 1, page = 2 };
+
+/** Emulation of the SSD1306 controller with a 128x64 GDDRAM
+
+    It receives the bytes already classified as commands or data to
+    GDDRAM and it follows the sections '9 Command Table' and '10
+    Command Descriptions' of the datasheet. The state after the
+    construction is the reset state described by the datasheet.
+
+    Commands are executed after the last argument is received. Data
+    bytes are written at the address pointer, which is incremented
+    according to the addressing mode and the page/column windows.
+
+    The emulation of the scrolling is limited to its state, the
+    GDDRAM isn't shifted. A data byte written while the scrolling is
+    active is counted as a violation of the datasheet rule that
+    requires the deactivation(0x2E) before any write to the GDDRAM.
+*/
+class controller {
+    uint8_t _cmd[7];
+    uint8_t _ncmd{0};
+
+    static uint8_t args_of(uint8_t cmd) {
+        switch(cmd) {
+        case 0x20: case 0x81: case 0x8d: case 0xa8: case 0xd3:
+        case 0xd5: case 0xd9: case 0xda: case 0xdb:
+            return 1;
+        case 0x21: case 0x22: case 0xa3:
+            return 2;
+        case 0x29: case 0x2a:
+            return 5;
+        case 0x26: case 0x27:
+            return 6;
+        default:
+            return 0;
+        }
+    }
+
+    void execute() {
+        auto c = _cmd[0];
+        if(c <= 0x0f) col = (col & 0xf0) | c;
+        else if(c <= 0x1f) col = ((c & 0x07) << 4) | (col & 0x0f);
+        else if(c == 0x20) {
+            if((_cmd[1] & 0x03) != 0x03) mode = addressing(_cmd[1] & 0x03);
+        } else if(c == 0x21) {
+            col_start = _cmd[1] & 0x7f;
+            col_end = _cmd[2] & 0x7f;
+            col = col_start;
+        } else if(c == 0x22) {
+            page_start = _cmd[1] & 0x07;
+            page_end = _cmd[2] & 0x07;
+            page = page_start;
+        } else if(c == 0x26 || c == 0x27 || c == 0x29 || c == 0x2a) {
+            scroll_setup = c;
+            for(uint8_t i{1}; i < 7; ++i) scroll_args[i - 1] = _cmd[i];
+        } else if(c == 0x2e) scrolling = false;
+        else if(c == 0x2f) scrolling = true;
+        else if(c >= 0x40 && c <= 0x7f) start_line = c & 0x3f;
+        else if(c == 0x81) contrast = _cmd[1];
+        else if(c == 0x8d) charge_pump = _cmd[1] & 0x04;
+        else if(c == 0xa0 || c == 0xa1) segment_remap = c & 0x01;
+        else if(c == 0xa3) {
+            vscroll_top = _cmd[1] & 0x3f;
+            vscroll_rows = _cmd[2] & 0x7f;
+        } else if(c == 0xa4 || c == 0xa5) entire_on = c & 0x01;
+        else if(c == 0xa6 || c == 0xa7) inverse = c & 0x01;
+        else if(c == 0xa8) {
+            if((_cmd[1] & 0x3f) >= 15) mux = (_cmd[1] & 0x3f) + 1;
+        } else if(c == 0xae || c == 0xaf) on = c & 0x01;
+        else if(c >= 0xb0 && c <= 0xb7) page = c & 0x07;
+        else if(c == 0xc0 || c == 0xc8) com_remap = c & 0x08;
+        else if(c == 0xd3) offset = _cmd[1] & 0x3f;
+        else if(c == 0xd5) clock = _cmd[1];
+        else if(c == 0xd9) precharge = _cmd[1];
+        else if(c == 0xda) com_pins = _cmd[1];
+        else if(c == 0xdb) vcomh = _cmd[1];
+        else if(c != 0xe3) ++unknown_commands;
+        ++commands;
+    }
+
+    void advance() {
+        if(mode == addressing::page) {
+            if(col == 127) col = 0; else ++col;
+        } else if(mode == addressing::horizontal) {
+            if(col == col_end) {
+                col = col_start;
+                page = page == page_end ? page_start : page + 1;
+            } else ++col;
+        } else {
+            if(page == page_end) {
+                page = page_start;
+                col = col == col_end ? col_start : col + 1;
+            } else ++page;
+        }
+    }
+public:
+    static constexpr uint8_t width{128};
+    static constexpr uint8_t height{64};
+    static constexpr uint8_t pages{height / 8};
+
+    uint8_t gddram[pages][width];
+
+    addressing mode{addressing::page};
+    uint8_t page{0}, col{0};
+    uint8_t page_start{0}, page_end{7};
+    uint8_t col_start{0}, col_end{127};
+
+    uint8_t start_line{0}, offset{0}, mux{64};
+    uint8_t contrast{0x7f}, clock{0x80}, precharge{0x22};
+    uint8_t com_pins{0x12}, vcomh{0x20};
+    bool segment_remap{false}, com_remap{false};
+    bool inverse{false}, entire_on{false}, on{false};
+    bool charge_pump{false};
+
+    bool scrolling{false};
+    uint8_t scroll_setup{0}, scroll_args[6]{};
+    uint8_t vscroll_top{0}, vscroll_rows{64};
+
+    uint32_t commands{0}, unknown_commands{0};
+    uint32_t data_bytes{0}, writes_while_scrolling{0};
+
+    controller() {
+        for(auto& p : gddram)
+            for(auto& b : p) b = 0x00;
+    }
+
+    /** Receives one command byte or one argument of a command. */
+    void command(uint8_t byte) {
+        _cmd[_ncmd++] = byte;
+        if(_ncmd > args_of(_cmd[0])) {
+            execute();
+            _ncmd = 0;
+        }
+    }
+
+    /** Writes one data byte to GDDRAM at the address pointer. */
+    void data(uint8_t byte) {
+        if(scrolling) ++writes_while_scrolling;
+        ++data_bytes;
+        gddram[page][col] = byte;
+        advance();
+    }
+
+    /** Level of the dot at the column 'x' and row 'y' of the GDDRAM. */
+    bool ram_dot(uint8_t x, uint8_t y) const
+    { return gddram[y / 8][x] & (1 << (y % 8)); }
+
+    /** Level of the dot at (x, y) as seen on the panel
+
+        (0, 0) is the top left corner of a module mounted in the usual
+        way, which is the one where the remaps 0xA1 and 0xC8 show the
+        column 0 of the page 0 at the top left corner. The start line,
+        the display offset, the multiplex ratio, the inverse and the
+        entire display on are considered. The remaps are applied only
+        to the order of SEG and COM outputs.
+    */
+    bool dot(uint8_t x, uint8_t y) const {
+        if(!on) return false;
+        if(entire_on) return true;
+        uint8_t com = height - 1 - y;
+        if(com >= mux) return inverse;
+        uint8_t seg = width - 1 - x;
+        uint8_t ram_col = segment_remap ? width - 1 - seg : seg;
+        uint8_t row = com_remap ? mux - 1 - com : com;
+        uint8_t ram_row = (row + start_line + offset) % height;
+        return ram_dot(ram_col, ram_row) != inverse;
+    }
+
+    /** Renders the panel using '#' to a lit dot and '.' to an unlit one. */
+    std::string ascii() const {
+        std::string s;
+        s.reserve((width + 1) * height);
+        for(uint8_t y{0}; y < height; ++y) {
+            for(uint8_t x{0}; x < width; ++x)
+                s += dot(x, y) ? '#' : '.';
+            s += '\n';
+        }
+        return s;
+    }
+};
+
+}}
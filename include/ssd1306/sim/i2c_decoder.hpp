@@ -0,0 +1,117 @@
+#pragma once
+
+#include "ssd1306/sim/board.hpp"
+
+#include <stdint.h>
+#include <functional>
+
+namespace ssd1306 { namespace sim {
+
+/** Bus activity observed by a decoder
+
+    clocks: rising edges of SCL, which includes the ACK clock of each
+    byte and any clock that doesn't belong to a complete byte.
+    stray_clocks: clocks discarded by a start or stop condition in
+    the middle of a byte.
+    races: rising edges of SCL that happened at the same instant of a
+    change of SDA.
+*/
+struct bus_stats {
+    uint32_t starts{0};
+    uint32_t stops{0};
+    uint32_t bytes{0};
+    uint32_t clocks{0};
+    uint32_t stray_clocks{0};
+    uint32_t races{0};
+
+    bus_stats operator-(const bus_stats& o) const {
+        return {starts - o.starts, stops - o.stops, bytes - o.bytes,
+                clocks - o.clocks, stray_clocks - o.stray_clocks,
+                races - o.races};
+    }
+};
+
+/** Pin-level I2C decoder
+
+    It watches the levels of the SDA and SCL pins on the 'board' and
+    translates the transitions to the events start, byte and stop:
+
+    - SDA falling while SCL is HIGH: start condition;
+    - SDA rising while SCL is HIGH: stop condition;
+    - SCL rising: one bit is sampled from SDA. The ninth clock is the
+      acknowledge clock and it completes a byte.
+
+    A start condition inside of a transaction is a repeated start and
+    it finishes the current transaction. This is what happens when
+    'i2c::stop_condition()' is called with SDA already HIGH, because
+    there isn't a rising edge of SDA in that case.
+
+    Sda, Scl: pin types from 'ssd1306::sim'.
+*/
+template<typename Sda, typename Scl>
+class i2c_decoder {
+    bool _sda, _scl;
+    bool _in_transaction{false};
+    uint8_t _byte{0}, _nbits{0};
+    bus_stats _stats;
+    std::size_t _handle;
+
+    void end_of_transaction() {
+        if(_nbits) _stats.stray_clocks += _nbits;
+        _nbits = 0;
+        _byte = 0;
+        if(_in_transaction && on_stop) on_stop();
+        _in_transaction = false;
+    }
+
+    void sample() {
+        bool sda = Sda::is_high(), scl = Scl::is_high();
+        if(sda == _sda && scl == _scl) return;
+        if(_scl && scl && sda != _sda) {
+            if(!sda) {
+                end_of_transaction();
+                ++_stats.starts;
+                _in_transaction = true;
+                if(on_start) on_start();
+            } else {
+                ++_stats.stops;
+                end_of_transaction();
+            }
+        } else if(!_scl && scl) {
+            ++_stats.clocks;
+            if(sda != _sda) ++_stats.races;
+            if(_in_transaction) {
+                if(++_nbits <= 8)
+                    _byte = (_byte << 1) | sda;
+                else {
+                    ++_stats.bytes;
+                    auto b = _byte;
+                    _nbits = 0;
+                    _byte = 0;
+                    if(on_byte) on_byte(b);
+                }
+            }
+        }
+        _sda = sda;
+        _scl = scl;
+    }
+public:
+    std::function<void()> on_start;
+    std::function<void(uint8_t)> on_byte;
+    std::function<void()> on_stop;
+
+    i2c_decoder()
+        : _sda(Sda::is_high())
+        , _scl(Scl::is_high())
+        , _handle(board::instance().observe([this]{ sample(); }))
+    {}
+
+    i2c_decoder(const i2c_decoder&) = delete;
+    i2c_decoder& operator=(const i2c_decoder&) = delete;
+
+    ~i2c_decoder() { board::instance().forget(_handle); }
+
+    const bus_stats& stats() const { return _stats; }
+};
+
+}}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "ssd1306/sim/board.hpp"
+#include "ssd1306/sim/registers.hpp"
+
+#include <stdint.h>
+
+namespace ssd1306 { namespace sim {
+
+/** Emulation of the TWI of the ATmega as a master transmitter
+
+    Each write to TWCR with TWINT and TWEN performs the requested
+    operation on the pins Sda and Scl, so the transfers can be seen by
+    a 'virtual_display' attached to the same pins, and after that it
+    sets TWINT and the status code of TWSR:
+
+    - TWSTA: start(0x08) or repeated start(0x10) condition;
+    - TWSTO: stop condition, TWSTO is cleared and TWINT isn't set;
+    - otherwise: the byte of TWDR plus one acknowledge clock with SDA
+      released. The status is 0x18 to the address and 0x28 to the
+      other bytes, the slave always acknowledges.
+
+    Layout: addresses of the registers, for example,
+            'ssd1306::atmega328p_twi'.
+    Sda, Scl: pin types from 'ssd1306::sim'.
+*/
+template<typename Layout, typename Sda, typename Scl>
+class twi_peripheral {
+    static constexpr uint8_t twint{1<<7}, twsta{1<<5}, twsto{1<<4},
+        twen{1<<2};
+    bool _in_transaction{false}, _addr{false};
+    std::size_t _handle;
+
+    static void status(uint8_t code) {
+        registers::poke(Layout::twsr,
+                        (registers::read(Layout::twsr) & 0x03) | code);
+    }
+
+    void start() {
+        if(_in_transaction) {
+            Sda::high();
+            Scl::high();
+        }
+        Sda::low();
+        Scl::low();
+        status(_in_transaction ? 0x10 : 0x08);
+        _in_transaction = _addr = true;
+    }
+
+    void shift(uint8_t byte) {
+        for(uint8_t i{8}; i > 0; --i) {
+            if(byte & 0x80) Sda::high(); else Sda::low();
+            byte <<= 1;
+            Scl::high();
+            Scl::low();
+        }
+        Sda::high();
+        Scl::high();
+        Scl::low();
+        status(_addr ? 0x18 : 0x28);
+        _addr = false;
+    }
+
+    void stop() {
+        Sda::low();
+        Scl::high();
+        Sda::high();
+        status(0xf8);
+        _in_transaction = false;
+    }
+public:
+    twi_peripheral()
+        : _handle(registers::instance().observe([this](uint16_t a, uint8_t v){
+            if(a != Layout::twcr || (v & (twint | twen)) != (twint | twen))
+                return;
+            if(v & twsto) {
+                stop();
+                registers::poke(Layout::twcr, v & ~(twint | twsto));
+                return;
+            }
+            if(v & twsta) start();
+            else shift(registers::read(Layout::twdr));
+            registers::poke(Layout::twcr, v);
+        }))
+    {}
+
+    twi_peripheral(const twi_peripheral&) = delete;
+    twi_peripheral& operator=(const twi_peripheral&) = delete;
+
+    ~twi_peripheral() { registers::instance().forget(_handle); }
+};
+
+/** Emulation of the USI of the ATtiny in the two-wire mode
+
+    A write to USICR with USICLK and USITC toggles Scl and increments
+    the 4-bit counter of USISR. At each rising edge the level of Sda
+    is sampled and at the falling edge USIDR is shifted. USIOIF is set
+    when the counter overflows and a write of one to one of the flags
+    of USISR clears it.
+
+    The MSB of USIDR is put on Sda when USIDR is written or shifted,
+    which models a port latch of SDA that is HIGH during the
+    transfers. The start and stop conditions are generated by the
+    pins.
+
+    Layout: addresses of the registers, for example,
+            'ssd1306::attiny85_usi'.
+    Sda, Scl: pin types from 'ssd1306::sim'.
+*/
+template<typename Layout, typename Sda, typename Scl>
+class usi_i2c_peripheral {
+    static constexpr uint8_t usiclk{1<<1}, usitc{1<<0};
+    bool _sample{true};
+    std::size_t _handle;
+
+    static void drive(uint8_t dr)
+    { if(dr & 0x80) Sda::high(); else Sda::low(); }
+public:
+    usi_i2c_peripheral()
+        : _handle(registers::instance().observe([this](uint16_t a, uint8_t v){
+            if(a == Layout::usisr) {
+                uint8_t flags = registers::read(Layout::usisr) & 0xf0;
+                flags &= ~(v & 0xe0);
+                registers::poke(Layout::usisr, flags | (v & 0x0f));
+                return;
+            }
+            if(a == Layout::usidr) {
+                drive(v);
+                return;
+            }
+            if(a != Layout::usicr || (v & (usiclk | usitc))
+               != (usiclk | usitc))
+                return;
+            if(!Scl::is_high()) {
+                Scl::high();
+                _sample = Sda::is_high();
+            } else {
+                Scl::low();
+                uint8_t dr = (registers::read(Layout::usidr) << 1) | _sample;
+                registers::poke(Layout::usidr, dr);
+                drive(dr);
+            }
+            auto sr = registers::read(Layout::usisr);
+            uint8_t cnt = (sr + 1) & 0x0f;
+            sr = (sr & 0xf0) | cnt;
+            if(!cnt) sr |= 1<<6;
+            registers::poke(Layout::usisr, sr);
+        }))
+    {}
+
+    usi_i2c_peripheral(const usi_i2c_peripheral&) = delete;
+    usi_i2c_peripheral& operator=(const usi_i2c_peripheral&) = delete;
+
+    ~usi_i2c_peripheral() { registers::instance().forget(_handle); }
+};
+
+}}
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "ssd1306/sim/board.hpp"
+#include "ssd1306/sim/registers.hpp"
+
+#include <stdint.h>
+#include <vector>
+
+namespace ssd1306 { namespace sim {
+
+/** Activity of an external memory
+
+    reads: sequential reads, one to each begin().
+    bytes: bytes that the memory started to send.
+*/
+struct memory_stats {
+    uint32_t reads{0};
+    uint32_t bytes{0};
+
+    memory_stats operator-(const memory_stats& o) const
+    { return {reads - o.reads, bytes - o.bytes}; }
+};
+
+/** Content of an external memory, the addresses after the end read
+    0xff like an erased chip. */
+class memory_content {
+protected:
+    std::vector<uint8_t> _bytes;
+    memory_stats _stats;
+    uint32_t _addr{0};
+
+    uint8_t next() {
+        ++_stats.bytes;
+        uint32_t a = _addr++;
+        return a < _bytes.size() ? _bytes[a] : 0xff;
+    }
+
+    void start(uint32_t addr) {
+        ++_stats.reads;
+        _addr = addr;
+    }
+public:
+    explicit memory_content(std::vector<uint8_t> bytes = {})
+        : _bytes(std::move(bytes))
+    {}
+
+    std::vector<uint8_t>& bytes() { return _bytes; }
+    const std::vector<uint8_t>& bytes() const { return _bytes; }
+
+    const memory_stats& stats() const { return _stats; }
+};
+
+/** Mock of the reader of an external memory
+
+    It has the operations of the readers of
+    'ssd1306/external_memory.hpp', so it's a source to
+    'send_from_memory()' without a bus.
+
+    Example:
+
+      sim::memory mem{image};
+      send_from_memory(disp.device(), mem, 0, page{0, 7},
+                       column{0, 127});
+*/
+class memory : public memory_content {
+public:
+    using memory_content::memory_content;
+
+    void begin(uint32_t addr) { start(addr); }
+    uint8_t read() { return next(); }
+    void end() {}
+};
+
+/** Virtual memory of the 25xx family attached to the pins, to be used
+    with 'spi_memory'
+
+    The command and the address are sampled at the rising edges of SCK
+    while CS# is LOW. After the address, each falling edge of SCK puts
+    the next bit of the data on SO. Only READ(0x03) is implemented.
+*/
+template<typename Sck, typename Mosi, typename Miso, typename Cs,
+         uint8_t AddrBytes = 3>
+class virtual_spi_memory : public memory_content {
+    bool _sck, _cs;
+    uint8_t _nbits{0}, _byte{0}, _bit{0};
+    uint32_t _header{0};
+    std::size_t _handle;
+
+    void header_bit(bool bit) {
+        _header = (_header << 1) | bit;
+        if(++_nbits < 8 * (1 + AddrBytes)) return;
+        if((_header >> (8 * AddrBytes)) == 0x03)
+            start(_header & ((uint32_t(1) << (8 * AddrBytes)) - 1));
+        _bit = 0;
+    }
+
+    void shift() {
+        if(_bit == 0) _byte = next();
+        if(_byte & (0x80 >> _bit)) Miso::high(); else Miso::low();
+        _bit = (_bit + 1) & 7;
+    }
+public:
+    explicit virtual_spi_memory(std::vector<uint8_t> bytes = {})
+        : memory_content(std::move(bytes))
+        , _sck(Sck::is_high())
+        , _cs(Cs::is_high())
+        , _handle(board::instance().observe([this]{
+            bool sck = Sck::is_high(), cs = Cs::is_high();
+            if(_cs != cs) {
+                _cs = cs;
+                _sck = sck;
+                _nbits = 0;
+                _header = 0;
+                return;
+            }
+            if(cs || sck == _sck) return;
+            _sck = sck;
+            bool reading = _nbits == 8 * (1 + AddrBytes);
+            if(sck && !reading) header_bit(Mosi::is_high());
+            else if(!sck && reading) shift();
+        }))
+    {}
+
+    virtual_spi_memory(const virtual_spi_memory&) = delete;
+    virtual_spi_memory& operator=(const virtual_spi_memory&) = delete;
+
+    ~virtual_spi_memory() { board::instance().forget(_handle); }
+};
+
+/** Virtual memory of the 24Cxx family attached to the emulated TWI of
+    the ATmega, to be used with 'twi_memory' and 'sim::registers'
+
+    The slave address and the address of the memory are taken from the
+    bytes written to TWDR and each read request puts the next byte in
+    TWDR. The transactions to other slave addresses are ignored, so it
+    can share the TWI with 'twi_peripheral'.
+*/
+template<typename Layout, uint8_t Addr = 0x50, uint8_t AddrBytes = 2>
+class virtual_twi_memory : public memory_content {
+    static constexpr uint8_t twint{1<<7}, twsta{1<<5}, twsto{1<<4},
+        twen{1<<2};
+    enum class state : uint8_t { idle, slave, address, read };
+    state _state{state::idle};
+    uint8_t _naddr{0};
+    uint32_t _target{0};
+    std::size_t _handle;
+
+    void written(uint8_t byte) {
+        if(_state == state::slave) {
+            if((byte >> 1) != Addr) _state = state::idle;
+            else if(byte & 1) {
+                start(_target);
+                _state = state::read;
+            } else {
+                _target = 0;
+                _naddr = 0;
+                _state = state::address;
+            }
+        } else if(_state == state::address && _naddr < AddrBytes) {
+            _target = (_target << 8) | byte;
+            ++_naddr;
+        }
+    }
+public:
+    explicit virtual_twi_memory(std::vector<uint8_t> bytes = {})
+        : memory_content(std::move(bytes))
+        , _handle(registers::instance().observe([this](uint16_t a, uint8_t v){
+            if(a != Layout::twcr || (v & (twint | twen)) != (twint | twen))
+                return;
+            if(v & twsto) _state = state::idle;
+            else if(v & twsta) _state = state::slave;
+            else if(_state == state::read)
+                registers::poke(Layout::twdr, next());
+            else written(registers::read(Layout::twdr));
+            if(v & twsto)
+                registers::poke(Layout::twcr, v & ~(twint | twsto));
+            else registers::poke(Layout::twcr, v);
+        }))
+    {}
+
+    virtual_twi_memory(const virtual_twi_memory&) = delete;
+    virtual_twi_memory& operator=(const virtual_twi_memory&) = delete;
+
+    ~virtual_twi_memory() { registers::instance().forget(_handle); }
+};
+
+}}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <vector>
+
+namespace ssd1306 { namespace sim {
+
+/** Host model of the memory mapped I/O registers
+
+    It has the interface of the register policy 'ssd1306::mmio', so
+    it can be passed to the hardware backends instead of it. The
+    registers are bytes indexed by their addresses in the data space
+    and all of them start with zero.
+
+    The peripherals are emulated by observers: each write calls them
+    with the address and the value after it's stored. An observer can
+    change the registers using poke(), which doesn't call the
+    observers, to set flags or to shift data like the hardware does.
+*/
+class registers {
+    static constexpr uint16_t size{0x100};
+    uint8_t _regs[size];
+    std::vector<std::function<void(uint16_t, uint8_t)>> _observers;
+
+    registers() { reset(); }
+public:
+    static registers& instance() {
+        static registers o;
+        return o;
+    }
+
+    /** Clears all registers. Observers are kept. */
+    void reset() {
+        for(auto& r : _regs) r = 0;
+    }
+
+    static uint8_t read(uint16_t addr) { return instance()._regs[addr]; }
+
+    static void write(uint16_t addr, uint8_t v) {
+        auto& o = instance();
+        o._regs[addr] = v;
+        for(auto& f : o._observers) f(addr, v);
+    }
+
+    /** Changes a register without calling the observers. */
+    static void poke(uint16_t addr, uint8_t v) { instance()._regs[addr] = v; }
+
+    /** Registers a callback and returns a handle to remove it. */
+    std::size_t observe(std::function<void(uint16_t, uint8_t)> f) {
+        _observers.push_back(std::move(f));
+        return _observers.size() - 1;
+    }
+
+    void forget(std::size_t handle)
+    { _observers[handle] = [](uint16_t, uint8_t){}; }
+};
+
+}}
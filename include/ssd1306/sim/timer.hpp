@@ -0,0 +1,42 @@
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+
+namespace ssd1306 { namespace sim {
+
+/** Periodic interrupt of the host simulation
+
+    The interrupt service routine is called once to each tick. The
+    program decides when the ticks happen, for example, one tick to
+    each iteration of the main loop, so the interleaving of the main
+    loop and of the interrupt is deterministic.
+
+    Example:
+
+      async_bus<i2c<pb0_t, pb2_t>> q;
+      sim::timer t0{[&]{ q.step(); }};
+      q.push(transfer::fill(0x00, 128 * 8));
+      while(!q.empty()) {
+          sample_sensors();
+          t0.tick();
+      }
+*/
+class timer {
+    std::function<void()> _isr;
+    uint32_t _ticks{0};
+public:
+    explicit timer(std::function<void()> isr) : _isr(std::move(isr)) {}
+
+    void tick(uint32_t n = 1) {
+        for(; n; --n) {
+            ++_ticks;
+            _isr();
+        }
+    }
+
+    /** Number of ticks since the construction. */
+    uint32_t ticks() const { return _ticks; }
+};
+
+}}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "ssd1306/i2c.hpp"
+#include "ssd1306/sim/controller.hpp"
+#include "ssd1306/sim/i2c_decoder.hpp"
+
+#include <stdint.h>
+
+namespace ssd1306 { namespace sim {
+
+/** Virtual SSD1306 attached to mock pins
+
+    It puts together an 'i2c_decoder' and a 'controller' following
+    the section '8.1.5 MCU I2C Interface' of the datasheet: the first
+    byte of a transaction is the slave address, the next one is a
+    control byte and after that the bytes are commands or data
+    according to the bits 'co' and 'dc' of the last control byte.
+
+    Transactions to another slave address are ignored, so two or
+    more virtual displays can share the same bus using different SA0
+    values.
+
+    Sda, Scl: pin types from 'ssd1306::sim'.
+    SA0: slave address bit. The default value is zero(off).
+
+    Example:
+
+      ssd1306::sim::virtual_display<pb0_t, pb2_t> panel;
+      ssd1306::display<pb0_t, pb2_t> disp{pb0, pb2};
+      auto before = panel.stats();
+      disp.out(page{0, 0}, column{0, 7}, bytes);
+      auto cost = panel.stats() - before;
+*/
+template<typename Sda, typename Scl, typename SA0 = sa0::off_t>
+class virtual_display {
+    enum class state { address, control, byte, ignore };
+    state _state{state::ignore};
+    bool _co{false}, _dc{false};
+    i2c_decoder<Sda, Scl> _decoder;
+    controller _ctrl;
+    uint32_t _transactions{0}, _ctrl_bytes{0};
+
+    void on_byte(uint8_t b) {
+        switch(_state) {
+        case state::address:
+            _state = b == i2c<Sda, Scl, SA0>::addr()
+                ? state::control : state::ignore;
+            if(_state == state::control) ++_transactions;
+            break;
+        case state::control:
+            ++_ctrl_bytes;
+            _co = b & (1<<7);
+            _dc = b & (1<<6);
+            _state = state::byte;
+            break;
+        case state::byte:
+            if(_dc) _ctrl.data(b); else _ctrl.command(b);
+            if(_co) _state = state::control;
+            break;
+        case state::ignore:
+            break;
+        }
+    }
+public:
+    virtual_display() {
+        _decoder.on_start = [this]{ _state = state::address; };
+        _decoder.on_byte = [this](uint8_t b){ on_byte(b); };
+        _decoder.on_stop = [this]{ _state = state::ignore; };
+    }
+
+    controller& ctrl() { return _ctrl; }
+    const controller& ctrl() const { return _ctrl; }
+
+    /** Activity of the bus, which includes other slaves. */
+    const bus_stats& stats() const { return _decoder.stats(); }
+
+    /** Number of transactions addressed to this display. */
+    uint32_t transactions() const { return _transactions; }
+
+    /** Number of control bytes addressed to this display. */
+    uint32_t ctrl_bytes() const { return _ctrl_bytes; }
+};
+
+}}
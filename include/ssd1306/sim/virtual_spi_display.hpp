@@ -0,0 +1,170 @@
+#pragma once
+
+#include "ssd1306/sim/board.hpp"
+#include "ssd1306/sim/controller.hpp"
+#include "ssd1306/sim/registers.hpp"
+
+#include <stdint.h>
+
+namespace ssd1306 { namespace sim {
+
+/** Activity of a SPI bus observed by a virtual display
+
+    selects: falling edges of CS#.
+    bytes: bytes received while CS# was LOW.
+    clocks: rising edges of SCLK while CS# was LOW.
+*/
+struct spi_stats {
+    uint32_t selects{0};
+    uint32_t bytes{0};
+    uint32_t clocks{0};
+
+    spi_stats operator-(const spi_stats& o) const
+    { return {selects - o.selects, bytes - o.bytes, clocks - o.clocks}; }
+};
+
+/** Virtual SSD1306 attached to a 4-wire SPI bus
+
+    The bytes are classified by the level of D/C# when they are
+    complete, which follows the section '8.1.3 MCU Serial Interface
+    (4-wire SPI)' of the datasheet. The bytes that arrive while CS# is
+    HIGH are ignored.
+
+    The bits come from one of the frontends below, which call
+    receive_bit() or receive_byte().
+
+    Dc, Cs: pin types from 'ssd1306::sim'.
+*/
+template<typename Dc, typename Cs>
+class spi_receiver {
+    bool _cs;
+    uint8_t _byte{0}, _nbits{0};
+    std::size_t _handle;
+protected:
+    controller _ctrl;
+    spi_stats _stats;
+
+    void receive_bit(bool bit) {
+        if(Cs::is_high()) return;
+        ++_stats.clocks;
+        _byte = (_byte << 1) | bit;
+        if(++_nbits == 8) {
+            receive_byte(_byte);
+            _nbits = 0;
+            _byte = 0;
+        }
+    }
+
+    void receive_byte(uint8_t b) {
+        if(Cs::is_high()) return;
+        ++_stats.bytes;
+        if(Dc::is_high()) _ctrl.data(b); else _ctrl.command(b);
+    }
+public:
+    spi_receiver()
+        : _cs(Cs::is_high())
+        , _handle(board::instance().observe([this]{
+            bool cs = Cs::is_high();
+            if(_cs && !cs) {
+                ++_stats.selects;
+                _nbits = 0;
+                _byte = 0;
+            }
+            _cs = cs;
+        }))
+    {}
+
+    spi_receiver(const spi_receiver&) = delete;
+    spi_receiver& operator=(const spi_receiver&) = delete;
+
+    ~spi_receiver() { board::instance().forget(_handle); }
+
+    controller& ctrl() { return _ctrl; }
+    const controller& ctrl() const { return _ctrl; }
+
+    const spi_stats& stats() const { return _stats; }
+};
+
+/** Virtual display that samples SDIN at each rising edge of SCLK,
+    to be used with the bit-banged 'spi'. */
+template<typename Sck, typename Mosi, typename Dc, typename Cs>
+class virtual_spi_display : public spi_receiver<Dc, Cs> {
+    bool _sck;
+    std::size_t _handle;
+public:
+    virtual_spi_display()
+        : _sck(Sck::is_high())
+        , _handle(board::instance().observe([this]{
+            bool sck = Sck::is_high();
+            if(!_sck && sck) this->receive_bit(Mosi::is_high());
+            _sck = sck;
+        }))
+    {}
+
+    ~virtual_spi_display() { board::instance().forget(_handle); }
+};
+
+/** Virtual display attached to the emulated SPI peripheral of the
+    ATmega, to be used with 'hw_spi' and 'sim::registers'. A write to
+    SPDR while the peripheral is enabled as master shifts the byte and
+    sets SPIF. */
+template<typename Layout, typename Dc, typename Cs>
+class virtual_hw_spi_display : public spi_receiver<Dc, Cs> {
+    std::size_t _handle;
+public:
+    virtual_hw_spi_display()
+        : _handle(registers::instance().observe([this](uint16_t a, uint8_t v){
+            if(a != Layout::spdr) return;
+            auto spcr = registers::read(Layout::spcr);
+            if(!(spcr & (1<<6)) || !(spcr & (1<<4))) return;
+            this->_stats.clocks += 8;
+            this->receive_byte(v);
+            registers::poke(Layout::spsr,
+                            registers::read(Layout::spsr) | (1<<7));
+        }))
+    {}
+
+    ~virtual_hw_spi_display() { registers::instance().forget(_handle); }
+};
+
+/** Virtual display attached to the emulated USI of the ATtiny in the
+    three-wire mode, to be used with 'usi_spi' and 'sim::registers'.
+
+    A write to USICR with USICLK and USITC toggles USCK and
+    increments the 4-bit counter of USISR. At each rising edge the
+    MSB of USIDR is sampled and USIDR is shifted. USIOIF is set when
+    the counter overflows and a write of one to it clears the flag.
+*/
+template<typename Layout, typename Dc, typename Cs>
+class virtual_usi_spi_display : public spi_receiver<Dc, Cs> {
+    std::size_t _handle;
+    bool _usck{false};
+public:
+    virtual_usi_spi_display()
+        : _handle(registers::instance().observe([this](uint16_t a, uint8_t v){
+            if(a == Layout::usisr) {
+                //USIOIF is cleared by writing one, the counter is written
+                uint8_t flags = registers::read(Layout::usisr) & 0xf0;
+                if(v & (1<<6)) flags &= ~(1<<6);
+                registers::poke(Layout::usisr, flags | (v & 0x0f));
+                return;
+            }
+            if(a != Layout::usicr || (v & 0x03) != 0x03) return;
+            _usck = !_usck;
+            if(_usck) {
+                auto dr = registers::read(Layout::usidr);
+                this->receive_bit(dr & 0x80);
+                registers::poke(Layout::usidr, dr << 1);
+            }
+            auto sr = registers::read(Layout::usisr);
+            uint8_t cnt = (sr + 1) & 0x0f;
+            sr = (sr & 0xf0) | cnt;
+            if(!cnt) sr |= 1<<6;
+            registers::poke(Layout::usisr, sr);
+        }))
+    {}
+
+    ~virtual_usi_spi_display() { registers::instance().forget(_handle); }
+};
+
+}}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "ssd1306/async_bus.hpp"
+#include "ssd1306/decimal.hpp"
+#include "ssd1306/send_seven_segment.hpp"
+#include "ssd1306/set_page_column.hpp"
+
+#include <stdint.h>
+
+namespace ssd1306 {
+
+/** Renderer that sends a region in slices of a bounded number of
+    bytes
+
+    A job is started by region(), fill() or digits() and each call to
+    step(max_bytes) sends at most 'max_bytes' bytes of it to the
+    GDDRAM, so the update of a region fits between the tasks of a main
+    loop that have hard deadlines. The job is resumed where the last
+    step stopped.
+
+    KeepOpen: if it's true, the data transaction is kept open between
+              the steps and only the first one sets the window. The
+              bus can't be used by anything else until the job is
+              finished or cancel() is called. If it's false, each step
+              is a complete transaction: the window is set to the
+              part of the region that remains. A step that stops in
+              the middle of a column sets a window with the rest of
+              that column only, which finishes at the end of the
+              column.
+
+    The bytes of the window commands and of the start of the
+    transactions aren't counted by 'max_bytes'.
+
+    Bus: transport with the static operations start_commands(),
+         start_data(), send_byte() and stop_condition().
+
+    precondition: the device is using the vertical addressing mode.
+
+    Example:
+
+      sliced_renderer<i2c<pb0_t, pb2_t>> r;
+      r.region(page{0, 7}, column{0, 127},
+               transfer::flash(dc::data, splash, 1024));
+      while(true) {
+          read_encoder();
+          r.step(16);
+      }
+*/
+template<typename Bus, bool KeepOpen = false>
+class sliced_renderer {
+    enum class job : uint8_t { none, bytes, digits };
+    job _job{job::none};
+    bool _open{false}, _narrow{false};
+    uint8_t _p0, _p1, _c1;
+    uint8_t _pg, _col;
+    uint16_t _pos;
+    transfer _src;
+
+    //digits
+    static constexpr uint8_t max_digits{10};
+    uint8_t _digits[max_digits];
+    uint8_t _w, _cell, _pages;
+    uint8_t _n, _d, _c;
+    const uint8_t *_edge, *_middle;
+    detail::digit_columns _cols;
+
+    void start(page pg, column col, job j) {
+        cancel();
+        _job = j;
+        _p0 = _pg = pg.start;
+        _p1 = pg.end;
+        _col = col.start;
+        _c1 = col.end;
+        _pos = 0;
+    }
+
+    /** Selects the column patterns of the digit '_d'. */
+    void load_digit() {
+        uint8_t s = _digits[_d] == digit_blank ? 0
+            : detail::read_flash(&detail::digit_segments<>::value
+                                 [_digits[_d]]);
+        _cols = detail::select_columns(_edge, _middle, _pages, s);
+    }
+
+    uint8_t next() const {
+        if(_job == job::bytes) return _src.at(_pos);
+        uint8_t p = _pg - _p0;
+        if(_c < 2) return detail::read_flash(_cols.left + p);
+        if(_c < _w - 2) return detail::read_flash(_cols.middle + p);
+        if(_c < _w) return detail::read_flash(_cols.right + p);
+        return 0x00;
+    }
+
+    /** Moves to the next byte. Returns true if a column was
+        finished. */
+    bool advance() {
+        ++_pos;
+        if(++_pg <= _p1) return false;
+        _pg = _p0;
+        ++_col;
+        if(_job == job::digits && ++_c == _cell) {
+            _c = 0;
+            if(++_d < _n) load_digit();
+        }
+        return true;
+    }
+public:
+    /** True if there is a job that isn't finished. */
+    bool busy() const { return _job != job::none; }
+
+    /** Sends the data bytes of 'src' to the region. 'src' is a
+        'transfer' from ram(), flash() or fill() with the size of the
+        region. */
+    void region(page pg, column col, const transfer& src) {
+        start(pg, col, job::bytes);
+        _src = src;
+    }
+
+    void fill(page pg, column col, uint8_t byte) {
+        region(pg, col, transfer::fill(byte, uint16_t(pg.end - pg.start + 1)
+                                       * (col.end - col.start + 1)));
+    }
+
+    /** Draws the decimal representation of 'v' with seven segment
+        digits like 'send_int()'. Only the start of 'pg' and 'col' are
+        used. The digits that don't fit before the column 127 aren't
+        drawn. */
+    template<uint8_t w, uint8_t h, uint8_t spacing = 5, typename UInt>
+    void digits(page pg, column col, UInt v, uint8_t width = 0) {
+        static_assert(w >= 12 && w <= 64);
+        static_assert(h % 16 == 0);
+        static_assert(h >= 16 && h <= 64);
+        constexpr uint8_t pages = h / 8;
+        uint8_t n{0};
+        for_each_digit(v, [&](uint8_t d){
+            if(n < max_digits) _digits[n++] = d;
+        }, width);
+        uint8_t fit = (128 - col.start) / (w + spacing);
+        if(n > fit) n = fit;
+        if(!n) {
+            cancel();
+            return;
+        }
+        start(page{pg.start, uint8_t(pg.start + pages - 1)},
+              column{col.start,
+                     uint8_t(col.start + n * (w + spacing) - 1)},
+              job::digits);
+        const auto& cols = detail::seven_segment_columns<pages>::value;
+        _edge = &cols.edge[0][0];
+        _middle = &cols.middle[0][0];
+        _w = w;
+        _cell = w + spacing;
+        _pages = pages;
+        _n = n;
+        _d = _c = 0;
+        load_digit();
+    }
+
+    /** Sends at most 'max_bytes' bytes of the job. Returns true if
+        there is more to send. */
+    bool step(uint16_t max_bytes) {
+        if(_job == job::none) return false;
+        if(!_open) {
+            _narrow = _pg != _p0;
+            if(_narrow) set(Bus{}, page{_pg, _p1}, column{_col, _col});
+            else set(Bus{}, page{_p0, _p1}, column{_col, _c1});
+            Bus::start_data();
+            _open = true;
+        }
+        for(; max_bytes && _col <= _c1; --max_bytes) {
+            Bus::send_byte(next());
+            if(advance() && _narrow) break;
+        }
+        bool more = _col <= _c1;
+        if(!more || !KeepOpen) {
+            Bus::stop_condition();
+            _open = false;
+        }
+        if(!more) _job = job::none;
+        return more;
+    }
+
+    /** Abandons the job, the open transaction is closed. */
+    void cancel() {
+        if(_open) Bus::stop_condition();
+        _open = false;
+        _job = job::none;
+    }
+};
+
+}
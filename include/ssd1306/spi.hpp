@@ -0,0 +1,158 @@
+#pragma once
+
+#include "ssd1306/mmio.hpp"
+
+#include <avr/io.hpp>
+
+namespace ssd1306 {
+
+/** 4-wire SPI communication interface
+
+    This abstraction follows the section '8.1.3 MCU Serial Interface
+    (4-wire SPI)' of the datasheet. There isn't a slave address, a
+    control byte or an acknowledge clock: the pin D/C# tells if a byte
+    is a command(LOW) or data to the GDDRAM(HIGH) and it's sampled at
+    the eighth clock of each byte. The bits are shifted MSB first and
+    they are sampled at the rising edge of SCLK(mode 0).
+
+    All SPI interfaces offer the same four operations of the
+    transport used by 'display', 'send_seven_segment.hpp' and
+    'set_page_column.hpp': start_commands(), start_data(), send_byte()
+    and stop_condition(). stop_condition() releases CS#.
+
+    Sck, Mosi, Dc, Cs: pins connected to D0(SCLK), D1(SDIN), D/C#
+                       and CS#.
+*/
+template<typename Sck, typename Mosi, typename Dc, typename Cs>
+struct spi {
+    spi() = default;
+
+    explicit spi(Sck sck, Mosi mosi, Dc dc, Cs cs) {
+        avr::io::out(sck, mosi, dc, cs);
+        Cs::high();
+        Sck::low();
+    }
+
+    /** Selects the device to receive a sequence of commands. */
+    static void start_commands() {
+        Dc::low();
+        Cs::low();
+    }
+
+    /** Selects the device to receive a sequence of data. */
+    static void start_data() {
+        Dc::high();
+        Cs::low();
+    }
+
+    /** Shift out the eight bits of a byte, MSB first. */
+    static void send_byte(uint8_t byte) {
+        for(uint8_t i{8}; i > 0; --i) {
+            Mosi::low();
+            if(byte & 0x80) Mosi::high();
+            byte <<= 1;
+            Sck::pulse();
+        }
+    }
+
+    /** Deselects the device. */
+    static void stop_condition() { Cs::high(); }
+};
+
+/** 4-wire SPI using the SPI peripheral of the ATmega
+
+    The peripheral is the master with the clock fosc/2, which is the
+    fastest one. send_byte() waits for the flag SPIF, so the next
+    byte can be written to SPDR.
+
+    Dc, Cs: pins connected to D/C# and CS#.
+    Regs: register policy, take a look at 'ssd1306/mmio.hpp'.
+    Layout: addresses of the registers, for example,
+            'atmega328p_spi'.
+
+    precondition: the pin SS is an output or it's HIGH, otherwise the
+    peripheral can leave the master mode.
+*/
+template<typename Dc, typename Cs, typename Regs = mmio,
+         typename Layout = atmega328p_spi>
+struct hw_spi {
+    static constexpr uint8_t spe{1<<6}, mstr{1<<4}, spif{1<<7}, spi2x{1<<0};
+
+    hw_spi() = default;
+
+    /** Sck and Mosi are the pins SCK and MOSI of the peripheral, they
+        are configured as outputs. */
+    template<typename Sck, typename Mosi>
+    hw_spi(Sck sck, Mosi mosi, Dc dc, Cs cs) {
+        avr::io::out(sck, mosi, dc, cs);
+        Cs::high();
+        Regs::write(Layout::spsr, spi2x);
+        Regs::write(Layout::spcr, spe | mstr);
+    }
+
+    static void start_commands() {
+        Dc::low();
+        Cs::low();
+    }
+
+    static void start_data() {
+        Dc::high();
+        Cs::low();
+    }
+
+    static void send_byte(uint8_t byte) {
+        Regs::write(Layout::spdr, byte);
+        while(!(Regs::read(Layout::spsr) & spif));
+    }
+
+    static void stop_condition() { Cs::high(); }
+};
+
+/** 4-wire SPI using the USI of the ATtiny in the three-wire mode
+
+    The clock is generated by software strobes of USITC, so each bit
+    costs two writes to USICR and there isn't a loop that shifts the
+    bits. DO is the data output and USCK is the clock.
+
+    Dc, Cs: pins connected to D/C# and CS#.
+    Regs: register policy, take a look at 'ssd1306/mmio.hpp'.
+    Layout: addresses of the registers, for example, 'attiny85_usi'.
+*/
+template<typename Dc, typename Cs, typename Regs = mmio,
+         typename Layout = attiny85_usi>
+struct usi_spi {
+    static constexpr uint8_t usiwm0{1<<4}, usics1{1<<3}, usiclk{1<<1},
+        usitc{1<<0}, usioif{1<<6};
+
+    usi_spi() = default;
+
+    /** Do and Usck are the pins DO and USCK of the USI, they are
+        configured as outputs. */
+    template<typename Do, typename Usck>
+    usi_spi(Do dout, Usck usck, Dc dc, Cs cs) {
+        avr::io::out(dout, usck, dc, cs);
+        Cs::high();
+        Regs::write(Layout::usicr, usiwm0);
+    }
+
+    static void start_commands() {
+        Dc::low();
+        Cs::low();
+    }
+
+    static void start_data() {
+        Dc::high();
+        Cs::low();
+    }
+
+    static void send_byte(uint8_t byte) {
+        Regs::write(Layout::usidr, byte);
+        Regs::write(Layout::usisr, usioif);
+        while(!(Regs::read(Layout::usisr) & usioif))
+            Regs::write(Layout::usicr, usiwm0 | usics1 | usiclk | usitc);
+    }
+
+    static void stop_condition() { Cs::high(); }
+};
+
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "ssd1306/i2c.hpp"
+
+#include <stdint.h>
+
+namespace ssd1306 {
+
+/** Bytes that are sent as commands or as data to the GDDRAM. */
+struct bus_segment {
+    dc mode;
+    const uint8_t* bytes;
+    uint8_t size;
+};
+
+namespace detail {
+
+/** First segment of the tail of the transaction [first, last],
+    which is the run of segments with the same mode of the last one. The
+    tail is streamed after a control byte with 'co == 0'. */
+inline uint8_t tail_of(const bus_segment* segs, uint8_t first,
+                       uint8_t last)
+{
+    while(last > first && segs[last - 1].mode == segs[last].mode) --last;
+    return last;
+}
+
+/** SCL clocks of the transaction with the segments [first, last]
+
+    The segments before the tail are sent as pairs (control byte with
+    'co == 1', byte) and the tail is streamed, so the cost is nine
+    clocks to the address, to each byte and to each control byte, plus
+    one clock to the stop condition.
+*/
+inline uint16_t transaction_clocks(const bus_segment* segs, uint8_t first,
+                                   uint8_t last)
+{
+    uint8_t tail = tail_of(segs, first, last);
+    uint16_t bytes{2};
+    for(uint8_t i{first}; i < tail; ++i) bytes += 2 * segs[i].size;
+    for(uint8_t i{tail}; i <= last; ++i) bytes += segs[i].size;
+    return 9 * bytes + 1;
+}
+
+template<typename I2C>
+inline void send_transaction(I2C&& i2c, const bus_segment* segs,
+                             uint8_t first, uint8_t last, bool stop = true)
+{
+    uint8_t tail = tail_of(segs, first, last);
+    i2c.start_condition();
+    i2c.send_slave_addr();
+    for(uint8_t i{first}; i < tail; ++i)
+        for(uint8_t j{0}; j < segs[i].size; ++j) {
+            i2c.send_ctrl_byte(segs[i].mode, co::on);
+            i2c.send_byte(segs[i].bytes[j]);
+        }
+    i2c.send_ctrl_byte(segs[last].mode);
+    for(uint8_t i{tail}; i <= last; ++i)
+        for(uint8_t j{0}; j < segs[i].size; ++j)
+            i2c.send_byte(segs[i].bytes[j]);
+    if(stop) i2c.stop_condition();
+}
+
+template<typename I2C>
+inline void send_plan(I2C&& i2c, const bus_segment* segs,
+                      const uint8_t* from, uint8_t n, bool stop_last)
+{
+    uint8_t first[8 + 1];
+    uint8_t count{0};
+    for(uint8_t i{n}; i > 0; i = from[i]) first[count++] = from[i];
+    for(uint8_t t{count}; t > 0; --t) {
+        uint8_t last = t == 1 ? n - 1 : first[t - 2] - 1;
+        send_transaction(i2c, segs, first[t - 1], last,
+                         t > 1 || stop_last);
+    }
+}
+
+} //namespace detail
+
+/** Splits a sequence of segments into transactions with the minimum
+    number of SCL clocks
+
+    There are two ways to send commands and data. Each one can use its
+    own transaction, which costs the address, a control byte and a
+    stop condition, or they can share one transaction using the
+    continuation bit('co == 1'), which costs one control byte to each
+    byte. The last run of segments of a transaction is always streamed
+    with 'co == 0'. Each merged command byte costs nine clocks of its
+    control byte and a transaction of its own costs 19 clocks, so one
+    or two command bytes followed by data, like a change of page in
+    the page addressing mode, are cheaper as one transaction, while
+    three or more, like the six bytes of a window, are cheaper as two
+    transactions, no matter the size of the data.
+
+    The plan is found by dynamic programming over the segments. 'from'
+    receives, to each i in [1, N], the first segment of the
+    transaction that ends at the segment 'i - 1'. Returns the SCL
+    clocks of the plan.
+
+    N: number of segments, at most 8.
+*/
+template<uint8_t N>
+inline uint16_t plan(const bus_segment (&segs)[N], uint8_t (&from)[N + 1]) {
+    static_assert(N >= 1 && N <= 8, "the plan has from 1 to 8 segments");
+    uint16_t best[N + 1];
+    best[0] = 0;
+    for(uint8_t i{1}; i <= N; ++i) {
+        best[i] = 0xffff;
+        for(uint8_t j{0}; j < i; ++j) {
+            uint16_t c = best[j] + detail::transaction_clocks(segs, j, i - 1);
+            if(c < best[i]) {
+                best[i] = c;
+                from[i] = j;
+            }
+        }
+    }
+    return best[N];
+}
+
+/** Sends the segments following the cheapest plan. Returns the SCL
+    clocks.
+
+    Example:
+
+      const uint8_t cmds[] = {0xb3, 0x04, 0x12};
+      const uint8_t bytes[] = {0x3c, 0x42};
+      send_segments(i2c, {bus_segment{dc::command, cmds, 3},
+                          bus_segment{dc::data, bytes, 2}});
+*/
+template<typename I2C, uint8_t N>
+inline uint16_t send_segments(I2C&& i2c, const bus_segment (&segs)[N]) {
+    uint8_t from[N + 1];
+    auto clocks = plan(segs, from);
+    detail::send_plan(i2c, segs, from, N, true);
+    return clocks;
+}
+
+/** Sends the segments followed by the start of an open segment with
+    the mode 'tail', which isn't finished by this call: the caller
+    sends its bytes and the stop condition. The size of the open
+    segment doesn't change the plan because it's always streamed.
+
+    Example:
+
+      start_segments(i2c, {bus_segment{dc::command, cmds, 3}}, dc::data);
+      for(auto b : bytes) i2c.send_byte(b);
+      i2c.stop_condition();
+*/
+template<typename I2C, uint8_t N>
+inline void start_segments(I2C&& i2c, const bus_segment (&segs)[N],
+                           dc tail)
+{
+    static_assert(N <= 7, "the plan has from 1 to 8 segments");
+    bus_segment all[N + 1];
+    for(uint8_t i{0}; i < N; ++i) all[i] = segs[i];
+    all[N] = bus_segment{tail, nullptr, 0};
+    uint8_t from[N + 2];
+    plan(all, from);
+    detail::send_plan(i2c, all, from, N + 1, false);
+}
+
+}
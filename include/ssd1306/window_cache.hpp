@@ -0,0 +1,368 @@
+#pragma once
+
+#include "ssd1306/set_page_column.hpp"
+#include "ssd1306/transaction_planner.hpp"
+
+#include <stdint.h>
+
+namespace ssd1306 {
+
+namespace detail {
+
+/** Device that calls 'track.step()' to each byte sent to another
+    one. */
+template<typename Dev, typename Track>
+struct tally {
+    Dev& dev;
+    Track& track;
+
+    void send_byte(uint8_t byte) {
+        dev.send_byte(byte);
+        track.step();
+    }
+};
+
+/** Device that keeps the commands of a window to be planned with
+    the next write. The buffer is emptied before each sequence, so
+    'capacity' is the longest sequence of 'window_cache', which is
+    checked at compile time. */
+struct command_buffer {
+    static constexpr uint8_t capacity{8};
+    uint8_t bytes[capacity];
+    uint8_t size{0};
+
+    void start_commands() {}
+    void send_byte(uint8_t byte) { bytes[size++] = byte; }
+    void stop_condition() {}
+};
+
+/** True if the bus has control bytes, like 'i2c', so commands and
+    data can share one transaction. */
+template<typename Bus, typename = void>
+struct has_ctrl_byte { static constexpr bool value{false}; };
+
+template<typename Bus>
+struct has_ctrl_byte<Bus, decltype(void(&Bus::send_ctrl_byte))>
+{ static constexpr bool value{true}; };
+
+} //namespace detail
+
+/** Window policy that doesn't remember anything
+
+    Each set() sends the window commands. The display doesn't use RAM
+    to this policy, it's an option to MCUs like the ATtiny13.
+*/
+struct no_window_cache {
+    void init() {}
+
+    template<typename Dev>
+    void release(Dev&&) {}
+
+    template<typename Dev>
+    void set(Dev&& dev, page pg, column col, uint16_t = 0)
+    { ::ssd1306::set(dev, pg, col); }
+
+    template<typename Dev>
+    void set(Dev&& dev, page pg) { ::ssd1306::set(dev, pg); }
+
+    template<typename Dev>
+    void set(Dev&& dev, column col) { ::ssd1306::set(dev, col); }
+
+    /** Sends a data transaction calling 'f' with the device. */
+    template<typename Dev, typename F>
+    void write(Dev& dev, F&& f, uint16_t = 0) {
+        dev.start_data();
+        f(dev);
+        dev.stop_condition();
+    }
+};
+
+/** Window policy that mirrors the address state of the controller
+
+    It remembers the addressing mode, the page/column windows and the
+    address pointer, which is advanced after each data write
+    following the rules of the datasheet. set() sends only the
+    commands that change something:
+
+    - nothing is sent when the window is already the requested one
+      and the pointer is at its start, for example, when a write
+      continues where the previous one stopped;
+    - 0x22 or 0x21 is sent alone when only the pages or only the
+      columns are different;
+    - when the window has one page and the length of the write is
+      known and fills the column window, the page addressing mode is
+      used if it's cheaper: 0xB0+page and the commands 0x00+low/0x10+
+      high nibble of the column, sending only the ones that change.
+      The mode is switched with 0x20 when it's needed and the cost of
+      the switch is considered.
+
+    The windows requested to the page addressing mode are remembered
+    and they are sent when the vertical addressing mode is used
+    again. A write that continues a previous one in the page
+    addressing mode moves the pointer back to the start of the column
+    window when it also fills the window. Otherwise, including when
+    its length isn't known, the vertical addressing mode is restored
+    with the remembered window, because the page addressing mode
+    doesn't wrap a write that crosses the end of the window. This
+    keeps the output equal to the one of 'no_window_cache'.
+
+    The commands aren't sent by set(), they are kept until the next
+    write, which uses 'start_segments()' to send them in the same
+    transaction of the data, with the continuation bit, when it's
+    cheaper. This happens when there are at most two command bytes,
+    like a change of page in the page addressing mode. A bus without
+    control bytes, like 'spi', receives the commands just before the
+    data.
+
+    The state starts unknown, which means that the controller is
+    using the vertical addressing mode but the windows and the
+    pointer aren't known. release() returns to this state, switching
+    back to the vertical addressing mode if it's needed, it must be
+    called before the device is used by someone else.
+*/
+class window_cache {
+    //Longest sequences kept in the command buffer: the switch to the
+    //vertical addressing mode with both windows, the switch to the
+    //page addressing mode with the page and the column, and the
+    //return to the start of the column window.
+    static constexpr uint8_t vertical_max{2 + 3 + 3}, page_max{2 + 1 + 2},
+        rewind_max{2};
+    static_assert(vertical_max <= detail::command_buffer::capacity
+                  && page_max <= detail::command_buffer::capacity
+                  && rewind_max <= detail::command_buffer::capacity,
+                  "the command buffer can't hold a window sequence");
+
+    enum class mode : uint8_t { unknown, vertical, page };
+    mode _mode{mode::unknown};
+    uint8_t _ps, _pe, _cs, _ce;
+    uint8_t _page, _col;
+    detail::command_buffer _cmds;
+
+    template<typename Dev>
+    void send_pending(Dev&& dev) {
+        if(!_cmds.size) return;
+        dev.start_commands();
+        for(uint8_t i{0}; i < _cmds.size; ++i) dev.send_byte(_cmds.bytes[i]);
+        dev.stop_condition();
+        _cmds.size = 0;
+    }
+
+    template<typename Dev>
+    static void vertical_cmds(Dev&& dev, bool switch_mode, bool pages,
+                              page pg, bool cols, column col)
+    {
+        dev.start_commands();
+        if(switch_mode) {
+            dev.send_byte(0x20);
+            dev.send_byte(0x01);
+        }
+        if(pages) {
+            dev.send_byte(0x22);
+            dev.send_byte(pg.start);
+            dev.send_byte(pg.end);
+        }
+        if(cols) {
+            dev.send_byte(0x21);
+            dev.send_byte(col.start);
+            dev.send_byte(col.end);
+        }
+        dev.stop_condition();
+    }
+
+    bool pages_differ(page pg) const {
+        return _mode != mode::vertical || pg.start != _ps || pg.end != _pe
+            || _page != _ps;
+    }
+
+    bool columns_differ(column col) const {
+        return _mode != mode::vertical || col.start != _cs || col.end != _ce
+            || _col != _cs;
+    }
+
+    /** Cost in bytes of the commands to use the page addressing
+        mode. */
+    uint8_t page_cost(page pg, column col) const {
+        if(_mode != mode::page) return 5;
+        return (_page != pg.start)
+            + ((_col & 0x0f) != (col.start & 0x0f))
+            + ((_col & 0xf0) != (col.start & 0xf0));
+    }
+
+    /** Cost in bytes of the commands to use the vertical addressing
+        mode. */
+    uint8_t vertical_cost(page pg, column col) const {
+        return (_mode == mode::page ? 2 : 0)
+            + (pages_differ(pg) ? 3 : 0) + (columns_differ(col) ? 3 : 0);
+    }
+
+    template<typename Dev>
+    void page_mode(Dev& dev, page pg, column col) {
+        bool switch_mode = _mode != mode::page;
+        dev.start_commands();
+        if(switch_mode) {
+            dev.send_byte(0x20);
+            dev.send_byte(0x02);
+        }
+        if(switch_mode || _page != pg.start)
+            dev.send_byte(0xb0 | pg.start);
+        if(switch_mode || (_col & 0x0f) != (col.start & 0x0f))
+            dev.send_byte(col.start & 0x0f);
+        if(switch_mode || (_col & 0xf0) != (col.start & 0xf0))
+            dev.send_byte(0x10 | (col.start >> 4));
+        dev.stop_condition();
+        _mode = mode::page;
+    }
+public:
+    /** State after the initialization of the display: vertical
+        addressing mode, whole screen and the pointer at (0, 0). */
+    void init() {
+        _mode = mode::vertical;
+        _ps = _page = 0;
+        _pe = 7;
+        _cs = _col = 0;
+        _ce = 127;
+    }
+
+    /** Switches back to the vertical addressing mode if it's needed
+        and forgets the windows and the pointer. */
+    template<typename Dev>
+    void release(Dev&& dev) {
+        send_pending(dev);
+        if(_mode == mode::page) {
+            dev.start_commands();
+            dev.send_byte(0x20);
+            dev.send_byte(0x01);
+            dev.stop_condition();
+        }
+        _mode = mode::unknown;
+    }
+
+    /** Sets the window of the next write. 'len' is the number of
+        bytes of the write or 0 if it isn't known. */
+    template<typename Dev>
+    void set(Dev&& bus, page pg, column col, uint16_t len = 0) {
+        send_pending(bus);
+        auto& dev = _cmds;
+        if(pg.start == pg.end && len == uint16_t(col.end - col.start + 1)
+           && page_cost(pg, col) < vertical_cost(pg, col))
+        {
+            if(page_cost(pg, col)) page_mode(dev, pg, col);
+            _ps = _pe = _page = pg.start;
+            _cs = _col = col.start;
+            _ce = col.end;
+            return;
+        }
+        bool pages = pages_differ(pg), cols = columns_differ(col);
+        if(pages || cols)
+            vertical_cmds(dev, _mode == mode::page, pages, pg, cols, col);
+        _mode = mode::vertical;
+        _ps = _page = pg.start;
+        _pe = pg.end;
+        _cs = _col = col.start;
+        _ce = col.end;
+    }
+
+    template<typename Dev>
+    void set(Dev&& bus, page pg) {
+        send_pending(bus);
+        auto& dev = _cmds;
+        if(_mode == mode::unknown) {
+            ::ssd1306::set(dev, pg);
+            return;
+        }
+        if(_mode == mode::page) {
+            if(_col > _ce) _col = _cs;
+            vertical_cmds(dev, true, true, pg, true, column{_col, _ce});
+            _cs = _col;
+        } else if(pages_differ(pg)) ::ssd1306::set(dev, pg);
+        _mode = mode::vertical;
+        _ps = _page = pg.start;
+        _pe = pg.end;
+    }
+
+    template<typename Dev>
+    void set(Dev&& bus, column col) {
+        send_pending(bus);
+        auto& dev = _cmds;
+        if(_mode == mode::unknown) {
+            ::ssd1306::set(dev, col);
+            return;
+        }
+        if(_mode == mode::page) {
+            vertical_cmds(dev, true, true, page{_ps, _pe}, true, col);
+            _page = _ps;
+        } else if(columns_differ(col)) ::ssd1306::set(dev, col);
+        _mode = mode::vertical;
+        _cs = _col = col.start;
+        _ce = col.end;
+    }
+
+    /** Advances the pointer by one byte, following the addressing
+        mode. */
+    void step() {
+        if(_mode == mode::vertical) {
+            if(++_page <= _pe) return;
+            _page = _ps;
+            if(++_col > _ce) _col = _cs;
+        } else if(_mode == mode::page && _col < 128) ++_col;
+    }
+
+    /** Advances the pointer by 'n' bytes at once, like 'n' calls to
+        step(). */
+    void advance(uint16_t n) {
+        if(_mode == mode::vertical) {
+            uint8_t pages = _pe - _ps + 1;
+            uint16_t size = uint16_t(pages) * (_ce - _cs + 1);
+            uint16_t i = uint16_t(_col - _cs) * pages + (_page - _ps);
+            i = (i + n % size) % size;
+            _col = _cs + i / pages;
+            _page = _ps + i % pages;
+        } else if(_mode == mode::page) {
+            uint16_t col = _col + n;
+            _col = col < 128 ? col : 128;
+        }
+    }
+
+    /** Sends a data transaction calling 'f' with the device. 'len' is
+        the number of bytes of the write, the pointer is advanced once
+        after it. If 'len' is 0 the length isn't known and 'f'
+        receives a device that advances the pointer to each byte. The
+        pending commands are planned with the data. */
+    template<typename Dev, typename F>
+    void write(Dev& dev, F&& f, uint16_t len = 0) {
+        //The pointer is only past the window after a write, so set()
+        //wasn't called after it and the command buffer is empty.
+        if(_mode == mode::page && _col > _ce) {
+            if(len == uint16_t(_ce - _cs + 1)) {
+                _cmds.send_byte(_cs & 0x0f);
+                _cmds.send_byte(0x10 | (_cs >> 4));
+            } else {
+                vertical_cmds(_cmds, true, true, page{_ps, _pe}, true,
+                              column{_cs, _ce});
+                _mode = mode::vertical;
+                _page = _ps;
+            }
+            _col = _cs;
+        }
+        if constexpr(detail::has_ctrl_byte<Dev>::value) {
+            if(_cmds.size) {
+                bus_segment cmds{dc::command, _cmds.bytes, _cmds.size};
+                start_segments(dev, {cmds}, dc::data);
+                _cmds.size = 0;
+            } else dev.start_data();
+        } else {
+            send_pending(dev);
+            dev.start_data();
+        }
+        if(len) {
+            f(dev);
+            advance(len);
+        } else {
+            detail::tally<Dev, window_cache> t{dev, *this};
+            f(t);
+        }
+        dev.stop_condition();
+    }
+};
+
+}
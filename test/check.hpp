@@ -0,0 +1,103 @@
+#pragma once
+
+#include <ssd1306/sim.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+/** Minimal checks of the host tests
+
+    Each test is a program that returns the number of failed checks,
+    so 'make check' stops at the first test that fails. The simulated
+    board and registers are global, reset() restores them between the
+    cases of a test.
+*/
+namespace test {
+
+inline int& failures() {
+    static int n{0};
+    return n;
+}
+
+inline void fail(const char* file, int line, const char* what) {
+    std::printf("%s:%d: check failed: %s\n", file, line, what);
+    ++failures();
+}
+
+inline void reset() {
+    ssd1306::sim::board::instance().reset();
+    ssd1306::sim::registers::instance().reset();
+}
+
+/** True if the windows [p0, p1] x [c0, c1] of both GDDRAMs are
+    equal. */
+template<typename A, typename B>
+bool same_gddram(const A& a, const B& b, uint8_t p0 = 0, uint8_t p1 = 7,
+                 uint8_t c0 = 0, uint8_t c1 = 127)
+{
+    for(uint8_t p{p0}; p <= p1; ++p)
+        for(uint8_t c{c0}; c <= c1; ++c)
+            if(a.gddram[p][c] != b.gddram[p][c]) return false;
+    return true;
+}
+
+/** True if the window of the GDDRAM has 'bytes' in the order of the
+    vertical addressing mode. */
+template<typename Ctrl>
+bool has_bytes(const Ctrl& ctrl, const uint8_t* bytes, uint8_t p0,
+               uint8_t p1, uint8_t c0, uint8_t c1)
+{
+    for(uint8_t c{c0}; c <= c1; ++c)
+        for(uint8_t p{p0}; p <= p1; ++p)
+            if(ctrl.gddram[p][c] != *bytes++) return false;
+    return true;
+}
+
+/** Device that records the bytes instead of sending them. */
+struct recorder {
+    std::vector<uint8_t> bytes;
+    void send_byte(uint8_t b) { bytes.push_back(b); }
+};
+
+/** Records the commands and the bytes written to the GDDRAM of any
+    slave of the bus in the order of the transactions, so two
+    implementations can be compared byte by byte. */
+template<typename Sda, typename Scl>
+class bus_recorder {
+    ssd1306::sim::i2c_decoder<Sda, Scl> _decoder;
+    enum class state { address, control, byte } _state{state::address};
+    bool _co{false}, _dc{false};
+public:
+    std::vector<uint8_t> commands, data;
+
+    bus_recorder() {
+        _decoder.on_start = [this]{ _state = state::address; };
+        _decoder.on_byte = [this](uint8_t b){
+            if(_state == state::address) _state = state::control;
+            else if(_state == state::control) {
+                _co = b & (1<<7);
+                _dc = b & (1<<6);
+                _state = state::byte;
+            } else {
+                (_dc ? data : commands).push_back(b);
+                if(_co) _state = state::control;
+            }
+        };
+    }
+};
+
+}
+
+#define CHECK(cond) \
+    do { if(!(cond)) ::test::fail(__FILE__, __LINE__, #cond); } while(0)
+
+#define CHECK_EQ(a, b) \
+    do { \
+        auto va = (a); auto vb = (b); \
+        if(!(va == vb)) { \
+            std::printf("%s:%d: %s == %s: %ld != %ld\n", __FILE__, \
+                        __LINE__, #a, #b, long(va), long(vb)); \
+            ++::test::failures(); \
+        } \
+    } while(0)
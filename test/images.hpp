@@ -0,0 +1,95 @@
+#pragma once
+
+#include <stdint.h>
+
+//Image of 1024 bytes with runs and literals, in the order of the
+//vertical addressing mode.
+constexpr uint8_t image[1024] = {
+    0, 0, 255, 255, 0, 0, 0, 0, 0, 0, 255, 255, 0, 0, 0, 0, 0, 0, 255, 255,
+    0, 0, 0, 0, 0, 0, 255, 255, 0, 0, 0, 0, 0, 0, 255, 255, 0, 0, 0, 0, 0,
+    0, 255, 255, 0, 0, 0, 0, 0, 0, 255, 255, 0, 0, 0, 0, 0, 0, 255, 255, 0,
+    0, 0, 0, 0, 0, 255, 255, 0, 0, 0, 0, 0, 0, 255, 255, 0, 0, 0, 0, 154,
+    191, 228, 9, 46, 83, 120, 157, 195, 232, 13, 50, 87, 124, 161, 198, 236,
+    17, 54, 91, 128, 165, 202, 239, 21, 58, 95, 132, 169, 206, 243, 24, 62,
+    99, 136, 173, 210, 247, 28, 65, 103, 140, 177, 214, 251, 32, 69, 106,
+    144, 181, 218, 255, 36, 73, 110, 147, 185, 222, 3, 40, 77, 114, 151,
+    188, 226, 7, 44, 81, 118, 155, 192, 229, 11, 48, 85, 122, 159, 196, 233,
+    14, 52, 89, 126, 163, 200, 237, 18, 55, 93, 130, 167, 204, 241, 22, 59,
+    96, 134, 171, 208, 245, 26, 63, 100, 137, 175, 212, 249, 30, 67, 104,
+    141, 178, 216, 253, 34, 71, 108, 145, 182, 219, 1, 38, 75, 112, 149,
+    186, 223, 4, 42, 79, 116, 153, 190, 227, 8, 45, 83, 120, 157, 194, 231,
+    12, 49, 86, 124, 161, 198, 235, 16, 53, 90, 127, 165, 202, 239, 20, 57,
+    94, 131, 168, 60, 60, 60, 60, 60, 60, 60, 60, 129, 129, 129, 129, 129,
+    129, 129, 129, 60, 60, 60, 60, 60, 60, 60, 60, 129, 129, 129, 129, 129,
+    129, 129, 129, 60, 60, 60, 60, 60, 60, 60, 60, 129, 129, 129, 129, 129,
+    129, 129, 129, 60, 60, 60, 60, 60, 60, 60, 60, 129, 129, 129, 129, 129,
+    129, 129, 129, 60, 60, 60, 60, 60, 60, 60, 60, 129, 129, 129, 129, 129,
+    129, 129, 129, 60, 60, 60, 60, 60, 60, 60, 60, 129, 129, 129, 129, 129,
+    129, 129, 129, 60, 60, 60, 60, 60, 60, 60, 60, 129, 129, 129, 129, 129,
+    129, 129, 129, 60, 60, 60, 60, 60, 60, 60, 60, 129, 129, 129, 129, 129,
+    129, 129, 129, 60, 60, 60, 60, 60, 60, 60, 60, 129, 129, 129, 129, 129,
+    129, 129, 129, 60, 60, 60, 60, 60, 60, 60, 60, 129, 129, 129, 129, 129,
+    129, 129, 129,
+};
+
+//Frames of a sprite that moves to the right over a static line.
+constexpr uint8_t frame0[1024] = {
+    0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 60, 0, 0, 0, 0,
+    0, 128, 0, 124, 0, 0, 0, 0, 0, 128, 0, 188, 0, 0, 0, 0, 0, 128, 0, 252,
+    24, 0, 0, 0, 0, 128, 0, 60, 24, 0, 0, 0, 0, 128, 0, 124, 0, 0, 0, 0, 0,
+    128, 0, 188, 0, 0, 0, 0, 0, 128, 0, 252, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0,
+    0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0,
+    0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128,
+    0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0,
+    128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0,
+    0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0,
+    0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0,
+    0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0,
+    128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128,
+};
+
+constexpr uint8_t frame1[1024] = {
+    0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0,
+    128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0,
+    0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0,
+    0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 60, 0, 0, 0, 0, 0, 128, 0,
+    124, 0, 0, 0, 0, 0, 128, 0, 188, 0, 0, 0, 0, 0, 128, 0, 252, 24, 0, 0,
+    0, 0, 128, 0, 60, 24, 0, 0, 0, 0, 128, 0, 124, 0, 0, 0, 0, 0, 128, 0,
+    188, 0, 0, 0, 0, 0, 128, 0, 252, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0,
+    0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0,
+    0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0,
+    0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128,
+    0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0,
+    128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128,
+};
+
+constexpr uint8_t frame2[1024] = {
+    0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0,
+    128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0,
+    0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0,
+    0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0,
+    0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0,
+    128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0,
+    0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 60, 0, 0, 0, 0, 0, 128, 0, 124,
+    0, 0, 0, 0, 0, 128, 0, 188, 0, 0, 0, 0, 0, 128, 0, 252, 24, 0, 0, 0, 0,
+    128, 0, 60, 24, 0, 0, 0, 0, 128, 0, 124, 0, 0, 0, 0, 0, 128, 0, 188, 0,
+    0, 0, 0, 0, 128, 0, 252, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128,
+    0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0,
+    128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128,
+};
+
+constexpr uint8_t frame3[1024] = {
+    0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0,
+    128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0,
+    0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0,
+    0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0,
+    0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0,
+    128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0,
+    0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0,
+    0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0,
+    0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0, 0, 0, 0, 0,
+    128, 0, 0, 0, 0, 0, 0, 0, 128, 0, 60, 0, 0, 0, 0, 0, 128, 0, 124, 0, 0,
+    0, 0, 0, 128, 0, 188, 0, 0, 0, 0, 0, 128, 0, 252, 24, 0, 0, 0, 0, 128,
+    0, 60, 24, 0, 0, 0, 0, 128, 0, 124, 0, 0, 0, 0, 0, 128, 0, 188, 0, 0, 0,
+    0, 0, 0, 0, 252,
+};
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <ssd1306.hpp>
+
+/** Copies of the baseline implementations that were replaced by the
+    optimized ones, the host tests check that both send the same
+    bytes. */
+namespace legacy {
+
+using ssd1306::seven_segment;
+namespace segment = ssd1306::segment;
+namespace segments = ssd1306::segments;
+
+template<int pages, typename I2C>
+inline void draw_column(I2C&& i2c, uint8_t b) {
+    for(uint8_t i{}; i < pages / 2; ++i)
+        i2c.send_byte(b);
+}
+
+//Seven segment digit drawn with branches to each column.
+template<uint8_t width, uint8_t height, uint8_t spacing = 3, typename I2C>
+void send_digit_segmented(I2C&& i2c, uint8_t segments) {
+    using namespace segment;
+    constexpr auto pages = height / 8;
+    for(uint8_t col{0}; col < width; ++col) {
+        if(col < 2) {
+            if(segments & left_top) draw_column<pages>(i2c, 0xff);
+            else draw_column<pages>(i2c, 0x00);
+            if(segments & left_bottom) draw_column<pages>(i2c, 0xff);
+            else draw_column<pages>(i2c, 0x00);
+        } else if(col >= 2 && col < (width - 2)) {
+            if(pages == 2) {
+                if(segments & top) {
+                    if(segments & middle) i2c.send_byte(0x83);
+                    else i2c.send_byte(0x03);
+                } else {
+                    if(segments & middle) i2c.send_byte(0x80);
+                    else i2c.send_byte(0x00);
+                }
+                if(segments & bottom) {
+                    if(segments & middle) i2c.send_byte(0xc1);
+                    else i2c.send_byte(0xc0);
+                } else {
+                    if(segments & middle) i2c.send_byte(0x01);
+                    else i2c.send_byte(0x00);
+                }
+            } else {
+                if(segments & top) i2c.send_byte(0x03);
+                else i2c.send_byte(0x00);
+                if(segments & middle) {
+                    draw_column<pages - 4>(i2c, 0x00);
+                    i2c.send_byte(0x80);
+                    i2c.send_byte(0x01);
+                } else draw_column<pages>(i2c, 0x00);
+                draw_column<pages - 4>(i2c, 0x00);
+                if(segments & bottom) i2c.send_byte(0xc0);
+                else i2c.send_byte(0x00);
+            }
+        } else if(col >= (width - 2) && col < width) {
+            if(segments & right_top) draw_column<pages>(i2c, 0xff);
+            else draw_column<pages>(i2c, 0x00);
+            if(segments & right_bottom) draw_column<pages>(i2c, 0xff);
+            else draw_column<pages>(i2c, 0x00);
+        }
+    }
+    for(uint8_t i{}; i < spacing * pages; ++i)
+        i2c.send_byte(0x00);
+}
+
+template<uint8_t width, uint8_t height, uint8_t spacing, typename I2C>
+void send_digit(I2C&& dev, uint8_t i) {
+    seven_segment digit;
+    if(i == 0) digit = segments::_0;
+    else if(i == 1) digit = segments::_1;
+    else if(i == 2) digit = segments::_2;
+    else if(i == 3) digit = segments::_3;
+    else if(i == 4) digit = segments::_4;
+    else if(i == 5) digit = segments::_5;
+    else if(i == 6) digit = segments::_6;
+    else if(i == 7) digit = segments::_7;
+    else if(i == 8) digit = segments::_8;
+    else  digit = segments::_9;
+    legacy::send_digit_segmented<width, height, spacing>(dev, digit.segments);
+}
+
+//Decimal conversion with recursion and divisions.
+template<uint8_t w, uint8_t h, uint8_t spacing = 5, typename I2C>
+uint8_t send_int(I2C&& dev, uint8_t i) {
+    if(i < 10) {
+        legacy::send_digit<w, h, spacing>(dev, i);
+        return 1;
+    }
+    auto d = legacy::send_int<w, h, spacing>(dev, uint8_t(i / 10));
+    return legacy::send_int<w, h, spacing>(dev, uint8_t(i % 10)) + d;
+}
+
+template<uint8_t w, uint8_t h, uint8_t spacing = 5, typename I2C>
+uint8_t send_int(I2C&& dev, uint32_t i) {
+    if(i < 10) {
+        legacy::send_digit<w, h, spacing>(dev, i);
+        return 1;
+    }
+    auto d = legacy::send_int<w, h, spacing>(dev, i / 10);
+    return legacy::send_int<w, h, spacing>(dev, i % 10) + d;
+}
+
+/** Body of 'display::out(page, column, int32_t)': 'n / 100' rounded
+    to one decimal place. */
+template<uint8_t w, uint8_t h, typename I2C>
+uint8_t send_decimal(I2C&& dev, int32_t n) {
+    uint32_t un;
+    if(n < 0) {
+        legacy::send_digit_segmented<w, h>(dev, segments::hyphen.segments);
+        un = n * -1;
+    } else un = n;
+    auto whole = un / 100;
+    auto decimal = un % 100;
+    auto d = decimal / 10;
+    auto r = decimal % 10;
+    if(r >= 5) {
+        if(d == 9) {
+            ++whole;
+            d = 0;
+        } else ++d;
+    }
+    auto n_digits = legacy::send_int<w, h>(dev, whole);
+    static const uint8_t dot[] = {
+        0x00, 0x00, 0x00, 0xf0,
+        0x00, 0x00, 0x00, 0xf0,
+        0x00, 0x00, 0x00, 0xf0,
+        0x00, 0x00, 0x00, 0xf0,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+    };
+    for(uint8_t i{}; i < sizeof(dot); ++i)
+        dev.send_byte(dot[i]);
+    return n_digits + legacy::send_int<w, h>(dev, d);
+}
+
+}
@@ -0,0 +1,43 @@
+#include "check.hpp"
+#include "images.hpp"
+
+#include <ssd1306.hpp>
+
+using namespace ssd1306;
+using namespace ssd1306::sim;
+
+static const uint8_t* frames[] = {frame0, frame1, frame2, frame3};
+
+int main() {
+    using anim = animation<frame0, frame1, frame2, frame3>;
+    CHECK_EQ(anim::frames, 4);
+
+    virtual_display<pb0_t, pb2_t> panel;
+    display<pb0_t, pb2_t> disp{pb0, pb2};
+    animation_player player{anim::span()};
+    CHECK_EQ(player.frame(), 0xff);
+
+    //two loops: each frame lands on the GDDRAM and a delta costs less
+    //than a whole screen
+    for(uint8_t i{0}; i < 10; ++i) {
+        auto before = panel.stats();
+        uint8_t f = player.next(disp.device());
+        auto cost = panel.stats() - before;
+        CHECK_EQ(f, i % 4);
+        CHECK(test::has_bytes(panel.ctrl(), frames[f], 0, 7, 0, 127));
+        CHECK(cost.bytes < 1024);
+    }
+
+    //one frame is drawn once and then nothing changes
+    using still = animation<frame0>;
+    animation_player one{still::span()};
+    test::reset();
+    virtual_display<pb0_t, pb2_t> panel1;
+    display<pb0_t, pb2_t> disp1{pb0, pb2};
+    one.next(disp1.device());
+    CHECK(test::has_bytes(panel1.ctrl(), frame0, 0, 7, 0, 127));
+    auto before = panel1.stats();
+    CHECK_EQ(one.next(disp1.device()), 0);
+    CHECK_EQ((panel1.stats() - before).bytes, 0u);
+    return test::failures();
+}
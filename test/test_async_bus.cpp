@@ -0,0 +1,65 @@
+#include "check.hpp"
+
+#include <ssd1306.hpp>
+
+using namespace ssd1306;
+using namespace ssd1306::sim;
+
+static const uint8_t img[] SSD1306_PROGMEM = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+static const uint8_t ram[] = {0xf0, 0x0f, 0xff};
+static int calls{0};
+
+int main() {
+    using bus_t = i2c<pb0_t, pb2_t>;
+
+    //reference: the same transfers sent directly
+    uint8_t ref[8][128];
+    {
+        virtual_display<pb0_t, pb2_t> panel;
+        display<pb0_t, pb2_t> disp{pb0, pb2};
+        set(bus_t{}, page{2, 2}, column{10, 19});
+        bus_t::start_data();
+        for(auto b : img) bus_t::send_byte(b);
+        bus_t::stop_condition();
+        set(bus_t{}, page{4, 4}, column{0, 2});
+        bus_t::start_data();
+        for(auto b : ram) bus_t::send_byte(b);
+        bus_t::stop_condition();
+        std::memcpy(ref, panel.ctrl().gddram, sizeof ref);
+    }
+
+    test::reset();
+    virtual_display<pb0_t, pb2_t> panel;
+    display<pb0_t, pb2_t> disp{pb0, pb2};
+    async_bus<bus_t, 4> q;
+    timer t0{[&]{ q.step(); }};
+    const transfer ts[] = {
+        transfer::window(page{2, 2}, column{10, 19}),
+        transfer::flash(dc::data, img, 10),
+        transfer::window(page{4, 4}, column{0, 2}),
+        transfer::ram(dc::data, ram, 3, []{ ++calls; })};
+    unsigned i{0}, rejected{0};
+    while(i < 4 || !q.empty()) {
+        if(i < 4) {
+            if(q.push(ts[i])) ++i;
+            else ++rejected;
+        }
+        t0.tick();
+    }
+    CHECK(!std::memcmp(ref, panel.ctrl().gddram, sizeof ref));
+    CHECK_EQ(calls, 1);
+    CHECK(q.done(q.pushed()));
+
+    //a ticket stays done after more than 127 completions and a
+    //pending one isn't done
+    auto first = q.pushed();
+    for(unsigned k{0}; k < 200; ++k) {
+        CHECK(q.push(transfer::fill(0x00, 1)));
+        auto t = q.pushed();
+        CHECK(!q.done(t));
+        while(!q.empty()) t0.tick();
+        CHECK(q.done(t));
+        CHECK(q.done(first));
+    }
+    return test::failures();
+}
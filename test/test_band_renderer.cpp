@@ -0,0 +1,74 @@
+#include "check.hpp"
+
+#include <ssd1306.hpp>
+
+using namespace ssd1306;
+using namespace ssd1306::sim;
+
+//Whole screen with the operations of a band, the reference of the
+//draw operations without bands.
+struct screen {
+    uint8_t gddram[8][128]{};
+
+    bool intersects(page, column) const { return true; }
+    void merge(uint8_t pg, uint8_t col, uint8_t byte)
+    { if(pg < 8 && col < 128) gddram[pg][col] |= byte; }
+    void dot(uint8_t x, uint8_t y) { merge(y / 8, x, 1 << (y % 8)); }
+};
+
+static auto digit = [](auto& dev){
+    send_digit_segmented<20, 32>(dev, segments::_7.segments);
+};
+
+template<typename Band>
+static void check(Band& b, page pg, column col, unsigned bands) {
+    auto fill = draw::fill{page{1, 2}, column{10, 50}, 0x81};
+    auto box = draw::box{0, 0, 127, 63};
+    auto num = draw::stream(page{4, 7}, column{60, 79}, digit);
+    screen ref;
+    fill(ref);
+    box(ref);
+    num(ref);
+
+    test::reset();
+    virtual_display<pb0_t, pb2_t> panel;
+    display<pb0_t, pb2_t> disp{pb0, pb2};
+    auto before = panel.stats();
+    render(disp.device(), b, pg, col, fill, box, num);
+    auto cost = panel.stats() - before;
+    //one command and one data transaction to each band
+    CHECK_EQ(cost.starts, 2 * bands);
+    CHECK_EQ(cost.bytes, bands * (2u * 2 + 6)
+             + (pg.end - pg.start + 1u) * (col.end - col.start + 1u));
+    screen got;
+    for(uint8_t p{pg.start}; p <= pg.end; ++p)
+        for(uint8_t c{col.start}; c <= col.end; ++c)
+            got.gddram[p][c] = ref.gddram[p][c];
+    CHECK(test::same_gddram(panel.ctrl(), got));
+}
+
+int main() {
+    //one band with the whole screen
+    band<8, 128> whole;
+    check(whole, page{0, 7}, column{0, 127}, 1);
+
+    //the last bands of each row and column are shortened: 3 rows
+    //of bands(3, 3 and 2 pages) and 6 columns(5 x 20 and 16)
+    band<3, 20> small;
+    check(small, page{0, 7}, column{4, 119}, 3 * 6);
+
+    //a region that isn't aligned to the bands
+    band<1, 32> strip;
+    check(strip, page{3, 5}, column{50, 90}, 3 * 2);
+
+    //place() clears the band and sets the shortened size
+    small.place(6, 120, 2, 8);
+    CHECK_EQ(small.first_page(), 6);
+    CHECK_EQ(small.last_page(), 7);
+    CHECK_EQ(small.last_column(), 127);
+    CHECK(!small.contains(5, 120));
+    CHECK(!small.contains(6, 128));
+    small.put(7, 127, 0xff);
+    CHECK(small.contains(7, 127));
+    return test::failures();
+}
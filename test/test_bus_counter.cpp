@@ -0,0 +1,55 @@
+#include "check.hpp"
+
+#include <ssd1306.hpp>
+
+using namespace ssd1306;
+using namespace ssd1306::sim;
+
+static const uint8_t bytes[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+int main() {
+    using counter = bus_counter<>;
+    virtual_display<pb0_t, pb2_t> panel;
+    display<pb0_t, pb2_t, sa0::off_t, counter, no_window_cache>
+        disp{pb0, pb2};
+
+    //the totals agree with the bus decoded from the pins
+    auto before = panel.stats();
+    counter::reset();
+    disp.out(page{1, 1}, column{0, 7}, bytes);
+    disp.out(page{2, 2}, column{0, 7}, uint8_t(0xaa),
+             repeat<uint8_t>{8});
+    auto bus = panel.stats() - before;
+    CHECK_EQ(counter::total.starts, bus.starts);
+    CHECK_EQ(counter::total.bytes(), bus.bytes);
+    //two windows of six command bytes and two data transactions
+    CHECK_EQ(counter::total.payload_bytes, 2u * 6 + 2 * 8);
+    CHECK_EQ(counter::total.stops, counter::total.starts);
+    CHECK_EQ(counter::total.scl_pulses,
+             9 * counter::total.bytes() + counter::total.stops);
+
+    //the transaction has only the last data transaction
+    const auto& t = counter::transaction;
+    CHECK_EQ(t.starts, 1u);
+    CHECK_EQ(t.stops, 1u);
+    CHECK_EQ(t.addr_bytes, 1u);
+    CHECK_EQ(t.ctrl_bytes, 1u);
+    CHECK_EQ(t.payload_bytes, 8u);
+    CHECK_EQ(t.scl_pulses, 9u * 10 + 1);
+
+    //the commands of a window are payload of a command transaction
+    counter::reset();
+    set(disp.device(), page{0, 7}, column{0, 127});
+    CHECK_EQ(counter::total.starts, 1u);
+    CHECK_EQ(counter::total.ctrl_bytes, 1u);
+    CHECK_EQ(counter::total.payload_bytes, 6u);
+
+    //the difference of two snapshots
+    auto a = counter::total;
+    disp.out(page{3, 3}, column{0, 7}, bytes);
+    auto d = counter::total - a;
+    CHECK_EQ(d.starts, 2u);
+    CHECK_EQ(d.payload_bytes, 6u + 8);
+    CHECK(test::has_bytes(panel.ctrl(), bytes, 3, 3, 0, 7));
+    return test::failures();
+}
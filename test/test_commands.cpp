@@ -0,0 +1,55 @@
+#include "check.hpp"
+
+#include <ssd1306.hpp>
+
+using namespace ssd1306;
+using namespace ssd1306::sim;
+
+using bus_t = i2c<pb0_t, pb2_t>;
+using bytes = std::vector<uint8_t>;
+
+template<typename F>
+static bytes commands_of(F send) {
+    test::reset();
+    bus_t bus{pb0, pb2};
+    test::bus_recorder<pb0_t, pb2_t> rec;
+    send(bus);
+    return rec.commands;
+}
+
+int main() {
+    //send_commands() sends what it's given, also the reset values
+    CHECK(commands_of([](bus_t& bus){ send_commands(bus, turn_off{}); })
+          == bytes({0xae}));
+    CHECK(commands_of([](bus_t& bus)
+                      { send_commands(bus, inverse_display<false>{}); })
+          == bytes({0xa6}));
+    CHECK(commands_of([](bus_t& bus){
+              send_commands(bus, contrast<0x10>{}, com_pins<true>{},
+                            contrast<0xff>{});
+          }) == bytes({0x81, 0x10, 0xda, 0x12, 0x81, 0xff}));
+
+    //send_commands_from_reset() drops reset values and replaced ones
+    CHECK(commands_of([](bus_t& bus){
+              send_commands_from_reset(bus, contrast<0x10>{},
+                                       com_pins<true>{}, contrast<0xff>{},
+                                       turn_on{});
+          }) == bytes({0x81, 0xff, 0xaf}));
+    CHECK(commands_of([](bus_t& bus)
+                      { send_commands_from_reset(bus, turn_off{}); })
+          .empty());
+    CHECK(commands_of([](bus_t& bus)
+                      { send_commands_from_reset(bus, always<turn_off>{}); })
+          == bytes({0xae}));
+
+    //the display constructor drops the reset values
+    auto init = commands_of([](bus_t&){
+        display<pb0_t, pb2_t> disp{pb0, pb2, contrast<0x7f>{}, turn_on{}};
+    });
+    const bytes expected{0xc8, 0xa1, 0x20, 0x01, 0x22, 0x00, 0x07,
+                         0x21, 0x00, 0x7f, 0x8d, 0x14, 0xaf};
+    CHECK(init.size() >= expected.size()
+          && bytes(init.begin(), init.begin() + expected.size())
+             == expected);
+    return test::failures();
+}
@@ -0,0 +1,116 @@
+#include "check.hpp"
+
+#include <ssd1306.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace ssd1306;
+using namespace ssd1306::sim;
+
+using con_t = console<>;
+
+//Terminal of reference: all lines printed, the new line of '\n' and
+//of a full line is deferred to the next character.
+struct terminal {
+    std::vector<std::string> lines{""};
+    bool newline{false};
+
+    void print(const char* s) {
+        for(; *s; ++s) {
+            if(newline) {
+                lines.emplace_back();
+                newline = false;
+            }
+            if(*s == '\n') newline = true;
+            else {
+                lines.back() += *s;
+                if(lines.back().size() == con_t::width()) newline = true;
+            }
+        }
+    }
+
+    //Bytes of the line 'i' of the screen, the last eight lines are
+    //visible.
+    std::vector<uint8_t> row(uint8_t i) const {
+        std::size_t first = lines.size() > 8 ? lines.size() - 8 : 0;
+        test::recorder r;
+        if(first + i < lines.size())
+            for(char c : lines[first + i]) font5x7::send(r, c);
+        r.bytes.resize(128, 0x00);
+        return r.bytes;
+    }
+};
+
+template<typename Ctrl>
+static bool same_screen(const Ctrl& ctrl, const terminal& t) {
+    CHECK_EQ(ctrl.start_line % 8, 0);
+    for(uint8_t i{0}; i < 8; ++i) {
+        uint8_t pg = (ctrl.start_line / 8 + i) & 7;
+        auto row = t.row(i);
+        if(std::memcmp(ctrl.gddram[pg], row.data(), 128)) return false;
+    }
+    return true;
+}
+
+int main() {
+    virtual_display<pb0_t, pb2_t> panel;
+    display<pb0_t, pb2_t> disp{pb0, pb2};
+    con_t con;
+    terminal t;
+    auto print = [&](const char* s){
+        con.print(disp.device(), s);
+        t.print(s);
+        return same_screen(panel.ctrl(), t);
+    };
+
+    CHECK(print("boot\n"));
+    //the new line is deferred, the cursor stays on the first line
+    CHECK_EQ(con.cursor_line(), 0);
+    CHECK(print("a longer second line\n"));
+    CHECK(print("3\n4\n5\n6\n7\n8"));
+    CHECK_EQ(con.cursor_line(), 7);
+    CHECK_EQ(panel.ctrl().start_line, 0);
+
+    //each scroll moves the start line by one page and costs the
+    //start line command, the window of the new line and its bytes,
+    //which clear the old text of the page
+    const char* next[] = {"\nx", "\nshort", "\na much longer line",
+                          "\n", "\nwrap this line at the end of row",
+                          "\n9\n10\n11\n12\n13\n14\n15\n16\n17"};
+    for(uint8_t k{0}; k < 4; ++k) {
+        //a trailing '\n' alone doesn't send anything, the next one
+        //scrolls an empty line
+        if(k == 3) {
+            auto before = panel.stats();
+            CHECK(print("\n"));
+            CHECK_EQ((panel.stats() - before).bytes, 0u);
+        }
+        uint8_t top = panel.ctrl().start_line / 8;
+        //the page that is reused is the one of the top line
+        uint16_t old = uint16_t(t.lines[t.lines.size() - 8].size()) * 6;
+        uint16_t len = uint16_t(std::strlen(next[k]) - 1) * 6;
+        auto before = panel.stats();
+        CHECK(print(next[k]));
+        auto cost = panel.stats() - before;
+        CHECK_EQ(panel.ctrl().start_line, ((top + 1) & 7) * 8);
+        uint16_t data = len > old ? len : old;
+        //the window and the data are skipped when both are empty
+        uint32_t window = data ? (2 + 6) + 2 + data : 0;
+        CHECK_EQ(cost.bytes, 3 + window);
+    }
+    //a line longer than the width wraps
+    CHECK(print(next[4]));
+    CHECK_EQ(con.cursor_column(),
+             std::strlen(next[4]) - 1 - con_t::width());
+    CHECK(print(next[5]));
+    CHECK(t.lines.size() > 16);
+
+    //clear() returns to the start line 0 and an empty screen
+    con.clear(disp.device());
+    t = terminal{};
+    CHECK(same_screen(panel.ctrl(), t));
+    CHECK_EQ(panel.ctrl().start_line, 0);
+    CHECK(print("again"));
+    return test::failures();
+}
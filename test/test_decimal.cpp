@@ -0,0 +1,78 @@
+#include "check.hpp"
+#include "legacy.hpp"
+
+#include <ssd1306.hpp>
+
+using namespace ssd1306;
+using namespace ssd1306::sim;
+
+//send_int() without divisions sends the bytes of the recursive one.
+template<uint8_t w, uint8_t h, typename UInt>
+static void check_send_int(UInt n) {
+    test::recorder before, after;
+    auto d0 = legacy::send_int<w, h>(before, n);
+    auto d1 = send_int<w, h>(after, n);
+    CHECK_EQ(d0, d1);
+    CHECK(before.bytes == after.bytes);
+}
+
+struct cost { uint32_t bytes, clocks; };
+
+/** display::out(page, column, int32_t) sends the data bytes of the
+    baseline, which is replayed with the same window. Returns the bus
+    cost of the new implementation and of the baseline. */
+template<uint8_t w, uint8_t h>
+static void check_decimal(int32_t n, cost& now, cost& old) {
+    const page pg{0, h / 8 - 1};
+    const column col{0, 127};
+    test::reset();
+    virtual_display<pb0_t, pb2_t> panel;
+    display<pb0_t, pb2_t> disp{pb0, pb2};
+    uint8_t ref[8][128];
+    uint8_t d0;
+    std::vector<uint8_t> bytes;
+    {
+        test::bus_recorder<pb0_t, pb2_t> rec;
+        auto before = panel.stats();
+        auto& bus = disp.device();
+        set(bus, pg, col);
+        bus.start_data();
+        d0 = legacy::send_decimal<w, h>(bus, n);
+        bus.stop_condition();
+        auto c = panel.stats() - before;
+        old.bytes += c.bytes;
+        old.clocks += c.clocks;
+        bytes = rec.data;
+        std::memcpy(ref, panel.ctrl().gddram, sizeof ref);
+    }
+    test::reset();
+    virtual_display<pb0_t, pb2_t> panel1;
+    display<pb0_t, pb2_t> disp1{pb0, pb2};
+    test::bus_recorder<pb0_t, pb2_t> rec;
+    auto before = panel1.stats();
+    auto d1 = disp1.template out<w, h>(pg, col, n);
+    auto c = panel1.stats() - before;
+    now.bytes += c.bytes;
+    now.clocks += c.clocks;
+    CHECK_EQ(d0, d1);
+    CHECK(rec.data == bytes);
+    CHECK(!std::memcmp(ref, panel1.ctrl().gddram, sizeof ref));
+}
+
+int main() {
+    for(uint16_t n{0}; n < 256; ++n) check_send_int<20, 32>(uint8_t(n));
+    const uint32_t wide[] = {0, 9, 10, 99, 100, 65535, 65536, 999999,
+                             1000000000, 4294967295u};
+    for(auto n : wide) check_send_int<12, 16>(n);
+
+    const int32_t values[] = {0, 4, 5, 94, 95, 99, 100, 994, 995, 12345,
+                              -1, -5, -995, 2147483647, -2147483647};
+    cost now{0, 0}, old{0, 0};
+    for(auto n : values) check_decimal<12, 16>(n, now, old);
+    for(auto n : values) check_decimal<20, 32>(n, now, old);
+    std::printf("bus cost of out(page, column, int32_t): "
+                "bytes %u(baseline %u), clocks %u(baseline %u)\n",
+                now.bytes, old.bytes, now.clocks, old.clocks);
+    CHECK(now.bytes <= old.bytes);
+    return test::failures();
+}
@@ -0,0 +1,67 @@
+#include "check.hpp"
+
+#include <ssd1306.hpp>
+
+using namespace ssd1306;
+using namespace ssd1306::sim;
+
+static std::vector<uint8_t> content() {
+    std::vector<uint8_t> v(0x3000);
+    for(std::size_t i{0}; i < v.size(); ++i) v[i] = uint8_t(i * 7 + (i >> 8));
+    return v;
+}
+
+template<typename Panel>
+static bool from_addr(const Panel& panel, uint32_t addr, page pg,
+                      column col)
+{
+    auto v = content();
+    return test::has_bytes(panel.ctrl(), v.data() + addr, pg.start, pg.end,
+                           col.start, col.end);
+}
+
+int main() {
+    //mock: one sequential read, or one read to each burst
+    {
+        virtual_display<pb0_t, pb2_t> panel;
+        display<pb0_t, pb2_t> disp{pb0, pb2};
+        memory mem{content()};
+        send_from_memory(disp.device(), mem, 0x1000, page{0, 7},
+                         column{0, 127});
+        CHECK(from_addr(panel, 0x1000, page{0, 7}, column{0, 127}));
+        CHECK_EQ(mem.stats().reads, 1u);
+        send_from_memory<16>(disp.device(), mem, 0x123, page{2, 4},
+                             column{5, 40});
+        CHECK(from_addr(panel, 0x123, page{2, 4}, column{5, 40}));
+        CHECK_EQ(mem.stats().reads, 1u + (3 * 36 + 15) / 16);
+    }
+
+    //25xx on its own pins
+    {
+        test::reset();
+        virtual_display<pb0_t, pb2_t> panel;
+        display<pb0_t, pb2_t> disp{pb0, pb2};
+        virtual_spi_memory<pb5_t, pb3_t, pb4_t, pb1_t, 2> chip{content()};
+        spi_memory<pb5_t, pb3_t, pb4_t, pb1_t, 2> mem{pb5, pb3, pb4, pb1};
+        send_from_memory(disp.device(), mem, 0x2000, page{0, 7},
+                         column{0, 127});
+        CHECK(from_addr(panel, 0x2000, page{0, 7}, column{0, 127}));
+        CHECK_EQ(chip.stats().reads, 1u);
+    }
+
+    //24Cxx sharing the TWI with the display
+    {
+        test::reset();
+        using bus_t = twi_i2c<sa0::off_t, no_counter, registers>;
+        twi_peripheral<atmega328p_twi, pb0_t, pb2_t> twi;
+        virtual_display<pb0_t, pb2_t> panel;
+        virtual_twi_memory<atmega328p_twi> chip{content()};
+        bus_display<bus_t> disp{bus_t{twi_bitrate(16000000, 400000)}};
+        twi_memory<0x50, 2, registers> mem;
+        send_from_memory<32>(disp.device(), mem, 0x0777, page{0, 7},
+                             column{0, 127});
+        CHECK(from_addr(panel, 0x0777, page{0, 7}, column{0, 127}));
+        CHECK_EQ(chip.stats().reads, 1024u / 32);
+    }
+    return test::failures();
+}
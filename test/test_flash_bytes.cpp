@@ -0,0 +1,53 @@
+#include "check.hpp"
+
+#include <ssd1306.hpp>
+
+using namespace ssd1306;
+using namespace ssd1306::sim;
+
+static uint8_t img[1024], small[300];
+
+//Writes the same regions from the RAM or from the flash.
+template<typename D>
+static void paint(D& disp, bool from_flash) {
+    if(from_flash) {
+        disp.out(page{0, 7}, column{0, 127}, flash(img));
+        disp.out(page{2, 4}, column{10, 109}, flash(small));
+        disp.out(page{6, 6}, flash(small));
+        disp.out(column{5, 6}, flash_bytes{small, 4});
+    } else {
+        const uint8_t first[4] = {small[0], small[1], small[2], small[3]};
+        disp.out(page{0, 7}, column{0, 127}, img);
+        disp.out(page{2, 4}, column{10, 109}, small);
+        disp.out(page{6, 6}, small);
+        disp.out(column{5, 6}, first);
+    }
+}
+
+int main() {
+    for(uint16_t i{0}; i < 1024; ++i) img[i] = uint8_t(i * 13);
+    for(uint16_t i{0}; i < 300; ++i) small[i] = uint8_t(~i);
+
+    uint8_t ref[8][128];
+    bus_stats ram;
+    {
+        virtual_display<pb0_t, pb2_t> panel;
+        display<pb0_t, pb2_t> disp{pb0, pb2};
+        disp.out(page{0, 7}, column{0, 127}, flash(img));
+        CHECK(test::has_bytes(panel.ctrl(), img, 0, 7, 0, 127));
+        auto before = panel.stats();
+        paint(disp, false);
+        ram = panel.stats() - before;
+        std::memcpy(ref, panel.ctrl().gddram, sizeof ref);
+    }
+    test::reset();
+    virtual_display<pb0_t, pb2_t> panel;
+    display<pb0_t, pb2_t> disp{pb0, pb2};
+    auto before = panel.stats();
+    paint(disp, true);
+    auto rom = panel.stats() - before;
+    CHECK(!std::memcmp(ref, panel.ctrl().gddram, sizeof ref));
+    CHECK_EQ(rom.bytes, ram.bytes);
+    CHECK(test::has_bytes(panel.ctrl(), small, 2, 4, 10, 109));
+    return test::failures();
+}
@@ -0,0 +1,134 @@
+#include "check.hpp"
+
+#include <ssd1306.hpp>
+
+using namespace ssd1306;
+using namespace ssd1306::sim;
+
+//Proportional font of two pages, 'd' is missing.
+struct prop_rows {
+    static constexpr uint8_t height{12};
+    static constexpr uint8_t spacing{1};
+    static constexpr glyph_rows<12> glyphs[] = {
+        {'a', 3, {0b111, 0b101, 0b100, 0b010, 0b001, 0b111,
+                  0b110, 0b011, 0b101, 0b000, 0b010, 0b111}},
+        {'b', 16, {0xffff, 0x8001, 0x1234, 0x5678, 0x9abc, 0xdef0,
+                   0x0f0f, 0xf0f0, 0x3c3c, 0xc3c3, 0x8001, 0xffff}},
+        {'c', 1, {1, 0, 1, 1, 0, 0, 1, 0, 1, 1, 1, 0}},
+        {'e', 7, {0b1000001, 0b0100010, 0b0010100, 0b0001000,
+                  0b0010100, 0b0100010, 0b1000001, 0b1111111,
+                  0b0000000, 0b1010101, 0b0101010, 0b1100011}},
+    };
+};
+
+constexpr char subset[] = "eaea";
+
+using prop_font = font<prop_rows>;
+using subset_font = font<prop_rows, subset>;
+
+static const glyph_rows<12>* glyph_of(char c) {
+    for(auto& g : prop_rows::glyphs)
+        if(g.c == c) return &g;
+    return nullptr;
+}
+
+//Draws 's' pixel by pixel from the rows, skipping the characters that
+//aren't in 'used' (nullptr to all).
+static void reference(uint8_t (&gddram)[8][128], uint8_t p0, uint8_t c0,
+                      const char* s, const char* used)
+{
+    for(uint8_t col{c0}; *s; ++s) {
+        auto g = glyph_of(*s);
+        if(!g || (used && !std::strchr(used, *s))) continue;
+        for(uint8_t x{0}; x < g->width; ++x, ++col)
+            for(uint8_t r{0}; r < prop_rows::height; ++r)
+                if(g->rows[r] & (1 << (g->width - 1 - x)))
+                    gddram[p0 + r / 8][col] |= uint8_t(1 << (r % 8));
+        col += prop_rows::spacing;
+    }
+}
+
+//Draws 's' with 'Font' in a clean panel and checks the frame and that
+//the window has the length of the text.
+template<typename Font>
+static void check_text(uint8_t p0, uint8_t c0, const char* s,
+                       const char* used)
+{
+    test::reset();
+    virtual_display<pb0_t, pb2_t> panel;
+    display<pb0_t, pb2_t> disp{pb0, pb2};
+    auto before = panel.ctrl().data_bytes;
+    disp.out<Font>(page{p0, uint8_t(p0 + 1)}, column{c0, 127}, s);
+    struct { uint8_t gddram[8][128]; } ref{};
+    reference(ref.gddram, p0, c0, s, used);
+    CHECK(test::same_gddram(panel.ctrl(), ref));
+    CHECK_EQ(panel.ctrl().data_bytes - before,
+             uint32_t(text_columns<Font>(s) * Font::pages));
+}
+
+int main() {
+    //all glyphs: widths and offsets of each glyph in the order of the
+    //definition, 'd' isn't packed
+    using t = prop_font::tables_t;
+    static_assert(prop_font::pages == 2, "");
+    static_assert(prop_font::size == (3 + 16 + 1 + 7) * 2, "");
+    static_assert(sizeof(t::bytes) == prop_font::size, "");
+    static_assert(sizeof(t::index) == 'e' - 'a' + 1, "");
+    static_assert(sizeof(t::width) == 4, "");
+    const auto& all = prop_font::tables;
+    const uint8_t index[] = {0, 1, 2, 0xff, 3};
+    CHECK(!std::memcmp(all.index, index, sizeof index));
+    uint16_t offset{0};
+    for(uint8_t g{0}; g < 4; ++g) {
+        CHECK_EQ(all.width[g], prop_rows::glyphs[g].width);
+        CHECK_EQ(all.offset_lo[g] | all.offset_hi[g] << 8, offset);
+        offset += prop_rows::glyphs[g].width * prop_font::pages;
+    }
+    //the 16 columns of 'b' move the offsets past a byte
+    CHECK_EQ(all.offset_hi[3], 0u);
+    CHECK_EQ(all.offset_lo[3], (3 + 16 + 1) * 2u);
+    CHECK_EQ(prop_font::columns('a'), 4u);
+    CHECK_EQ(prop_font::columns('b'), 17u);
+    CHECK_EQ(prop_font::columns('d'), 0u);
+    CHECK_EQ(prop_font::columns('z'), 0u);
+    CHECK_EQ(text_columns<prop_font>("abcde"), 4u + 17 + 2 + 8);
+
+    //subset: only 'e' and 'a' are packed, once, in the order of 'Used'
+    using u = subset_font::tables_t;
+    static_assert(subset_font::size == (7 + 3) * 2, "");
+    static_assert(sizeof(u::bytes) == subset_font::size, "");
+    static_assert(sizeof(u::index) == 'e' - 'a' + 1, "");
+    static_assert(sizeof(u::width) == 2, "");
+    const auto& sub = subset_font::tables;
+    const uint8_t sub_index[] = {1, 0xff, 0xff, 0xff, 0};
+    CHECK(!std::memcmp(sub.index, sub_index, sizeof sub_index));
+    CHECK_EQ(sub.width[0], 7u);
+    CHECK_EQ(sub.width[1], 3u);
+    CHECK_EQ(sub.offset_lo[1], 7u * 2);
+    CHECK(!std::memcmp(sub.bytes + 7 * 2, all.bytes, 3 * 2));
+    CHECK_EQ(subset_font::columns('b'), 0u);
+    CHECK_EQ(text_columns<subset_font>("abe"), 4u + 8);
+
+    //the text is drawn glyph after glyph in the window, the missing
+    //characters aren't drawn
+    check_text<prop_font>(2, 10, "abxce", nullptr);
+    check_text<prop_font>(6, 70, "ebbd", nullptr);
+    check_text<subset_font>(0, 0, "abe", subset);
+
+    //font5x7 is the default font
+    test::reset();
+    virtual_display<pb0_t, pb2_t> panel;
+    display<pb0_t, pb2_t> disp{pb0, pb2};
+    auto before = panel.ctrl().data_bytes;
+    disp.out(page{5, 5}, column{40, 127}, "Hi!");
+    struct { uint8_t gddram[8][128]; } ref{};
+    uint8_t col{40};
+    for(const char* s = "Hi!"; *s; ++s, ++col)
+        for(uint8_t x{0}; x < 5; ++x)
+            ref.gddram[5][col++] =
+                detail::font5x7_glyphs<>::value[*s - ' '][x];
+    CHECK(test::same_gddram(panel.ctrl(), ref));
+    CHECK_EQ(panel.ctrl().data_bytes - before, 3u * 6);
+
+    return test::failures();
+}
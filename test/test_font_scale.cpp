@@ -0,0 +1,92 @@
+#include "check.hpp"
+
+#include <ssd1306.hpp>
+
+using namespace ssd1306;
+using namespace ssd1306::sim;
+
+//Proportional font of one page with bits at the borders of the
+//nibbles, which are split between bytes by the 3x expansion.
+struct small_rows {
+    static constexpr uint8_t height{8};
+    static constexpr uint8_t spacing{2};
+    static constexpr glyph_rows<8> glyphs[] = {
+        {'x', 3, {0b101, 0b010, 0b101, 0b010,
+                  0b100, 0b001, 0b111, 0b011}},
+        {'y', 1, {1, 1, 1, 1, 1, 1, 1, 1}},
+        {'z', 2, {0b10, 0b00, 0b01, 0b11, 0b00, 0b10, 0b01, 0b00}},
+    };
+};
+
+using small_font = font<small_rows>;
+
+//Column 'b' of one page expanded bit by bit: the bit 'i' is the rows
+//[i * Scale, (i + 1) * Scale) of the 'Scale' pages.
+template<uint8_t Scale>
+static void expand(uint8_t b, uint8_t (&out)[Scale]) {
+    for(uint8_t p{0}; p < Scale; ++p) out[p] = 0;
+    for(uint8_t i{0}; i < 8; ++i)
+        if(b >> i & 1)
+            for(uint8_t r = i * Scale; r < (i + 1) * Scale; ++r)
+                out[r / 8] |= uint8_t(1 << (r % 8));
+}
+
+//Every value of a column is sent as 'Scale' columns of 'Scale' bytes.
+template<uint8_t Scale>
+static void check_columns() {
+    for(uint16_t b{0}; b < 256; ++b) {
+        test::recorder rec;
+        detail::send_scaled_column<Scale>(rec, uint8_t(b));
+        uint8_t ref[Scale];
+        expand<Scale>(uint8_t(b), ref);
+        CHECK_EQ(rec.bytes.size(), size_t(Scale * Scale));
+        for(uint8_t i{0}; i < rec.bytes.size(); ++i)
+            CHECK_EQ(rec.bytes[i], ref[i % Scale]);
+    }
+}
+
+//Draws 's' scaled in a clean panel and compares the frame against the
+//bytes of the small font expanded by the reference.
+template<typename Font, uint8_t Scale>
+static void check_text(uint8_t p0, uint8_t c0, const char* s) {
+    test::reset();
+    virtual_display<pb0_t, pb2_t> panel;
+    display<pb0_t, pb2_t> disp{pb0, pb2};
+    auto before = panel.ctrl().data_bytes;
+    disp.out<Font, Scale>(page{p0, uint8_t(p0 + Scale - 1)},
+                          column{c0, 127}, s);
+    struct { uint8_t gddram[8][128]; } ref{};
+    uint8_t col{c0};
+    for(; *s; ++s)
+        Font::for_each_byte(*s, [&](uint8_t b){
+            uint8_t bytes[Scale];
+            expand<Scale>(b, bytes);
+            for(uint8_t x{0}; x < Scale; ++x, ++col)
+                for(uint8_t p{0}; p < Scale; ++p)
+                    ref.gddram[p0 + p][col] = bytes[p];
+        });
+    CHECK(test::same_gddram(panel.ctrl(), ref));
+    CHECK_EQ(panel.ctrl().data_bytes - before, uint32_t(col - c0) * Scale);
+}
+
+template<uint8_t Scale>
+static void check_scale() {
+    check_columns<Scale>();
+    check_text<font5x7, Scale>(0, 3, "A%8");
+    check_text<font5x7, Scale>(8 - Scale, 60, "g|");
+    check_text<small_font, Scale>(1, 17, "xyzwx");
+    CHECK_EQ((text_columns<small_font, Scale>("xyzw")),
+             uint16_t((5 + 3 + 4) * Scale));
+}
+
+int main() {
+    //the scale 1 is the text of the small font
+    check_text<font5x7, 1>(3, 0, "Scale");
+    check_text<small_font, 1>(7, 100, "xyz");
+
+    check_scale<2>();
+    check_scale<3>();
+    check_scale<4>();
+
+    return test::failures();
+}
@@ -0,0 +1,97 @@
+#include "check.hpp"
+
+#include <ssd1306.hpp>
+
+using namespace ssd1306;
+using namespace ssd1306::sim;
+
+static const uint8_t bytes[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+static const uint8_t small[3] = {9, 10, 11};
+
+template<typename Disp>
+static void paint(Disp& d) {
+    d.out(page{0, 0}, column{0, 7}, bytes);
+    d.out(page{1, 3}, column{20, 60}, uint8_t(0x55),
+          repeat<uint16_t>{3 * 41});
+    d.template out<12, 16>(page{4, 5}, column{0, 127}, int32_t(-42));
+    set(d.device(), page{6, 7}, column{120, 123});
+    d.device().start_data();
+    for(uint8_t i{0}; i < 8; ++i) d.device().send_byte(0xf0 | i);
+    d.device().stop_condition();
+}
+
+int main() {
+    //the same drawing through both front ends gives the same frame
+    uint8_t direct[8][128];
+    {
+        test::reset();
+        virtual_display<pb0_t, pb2_t> panel;
+        display<pb0_t, pb2_t> disp{pb0, pb2};
+        paint(disp);
+        std::memcpy(direct, panel.ctrl().gddram, sizeof direct);
+    }
+    test::reset();
+    virtual_display<pb0_t, pb2_t> panel;
+    buffered_display<pb0_t, pb2_t> disp{pb0, pb2};
+    CHECK(!disp.fb().dirty());
+    auto before = panel.stats();
+    paint(disp);
+    CHECK_EQ((panel.stats() - before).bytes, 0u);
+    CHECK(disp.fb().dirty());
+    disp.flush();
+    CHECK(!disp.fb().dirty());
+    CHECK(!std::memcmp(direct, panel.ctrl().gddram, sizeof direct));
+
+    //a small change is sent with the tightest window: six command
+    //bytes and three data bytes, each transaction with its address
+    //and control bytes
+    before = panel.stats();
+    disp.out(page{2, 2}, column{30, 32}, small);
+    disp.flush();
+    auto cost = panel.stats() - before;
+    CHECK_EQ(cost.starts, 2u);
+    CHECK_EQ(cost.bytes, 2u * 2 + 6 + 3);
+    CHECK(test::has_bytes(panel.ctrl(), small, 2, 2, 30, 32));
+
+    //rewriting a byte with the value that it has isn't a change
+    disp.out(page{2, 2}, column{30, 32}, small);
+    CHECK(!disp.fb().dirty());
+    before = panel.stats();
+    disp.flush();
+    CHECK_EQ((panel.stats() - before).bytes, 0u);
+
+    //neighbour pages with the same columns are one rectangle, far
+    //apart changes are two
+    disp.fb().write(3, 40, 0x11);
+    disp.fb().write(4, 40, 0x22);
+    before = panel.stats();
+    disp.flush();
+    cost = panel.stats() - before;
+    CHECK_EQ(cost.starts, 2u);
+    CHECK_EQ(cost.bytes, 2u * 2 + 6 + 2);
+    disp.fb().write(0, 0, 0x33);
+    disp.fb().write(7, 127, 0x44);
+    before = panel.stats();
+    disp.flush();
+    cost = panel.stats() - before;
+    CHECK_EQ(cost.starts, 4u);
+    CHECK_EQ(cost.bytes, 2 * (2u * 2 + 6 + 1));
+    CHECK_EQ(panel.ctrl().gddram[3][40], 0x11);
+    CHECK_EQ(panel.ctrl().gddram[4][40], 0x22);
+    CHECK_EQ(panel.ctrl().gddram[0][0], 0x33);
+    CHECK_EQ(panel.ctrl().gddram[7][127], 0x44);
+
+    //the scroll is stopped by a flush with changes only
+    disp.scroll(horizontal_scroll<scroll_dir::left, 0, 7, 2>{});
+    CHECK(panel.ctrl().scrolling);
+    disp.flush();
+    CHECK(panel.ctrl().scrolling);
+    CHECK(disp.scrolling());
+    disp.fb().dot(5, 9);
+    disp.flush();
+    CHECK(!panel.ctrl().scrolling);
+    CHECK(!disp.scrolling());
+    CHECK_EQ(panel.ctrl().writes_while_scrolling, 0u);
+    CHECK_EQ(panel.ctrl().gddram[1][5], 0x02);
+    return test::failures();
+}
@@ -0,0 +1,71 @@
+#include "check.hpp"
+
+#include <ssd1306.hpp>
+
+using namespace ssd1306;
+using namespace ssd1306::sim;
+
+template<typename D>
+static void paint(D& disp) {
+    static const uint8_t bytes[] = {1, 2, 3, 4, 0xff};
+    disp.template out<20, 32>(page{0, 3}, column{0, 127}, -1234);
+    disp.out(page{5, 5}, column{3, 127}, bytes);
+    disp.out(page{6, 7}, column{0, 63}, uint8_t(0xaa), repeat<uint8_t>{128});
+}
+
+static_assert(twi_bitrate(16000000, 400000) == 12, "");
+static_assert(twi_bitrate(16000000, 100000) == 72, "");
+static_assert(twi_bitrate(1000000, 400000) == 0, "f_cpu / f_scl < 16");
+static_assert(twi_bitrate(16000000, 10000) == 255, "TWBR > 255");
+
+int main() {
+    //reference: the bit-banged interface
+    uint8_t ref[8][128];
+    bus_stats bitbang;
+    {
+        virtual_display<pb0_t, pb2_t> panel;
+        display<pb0_t, pb2_t> disp{pb0, pb2, turn_on{}};
+        paint(disp);
+        std::memcpy(ref, panel.ctrl().gddram, sizeof ref);
+        bitbang = panel.stats();
+    }
+
+    //TWI of the ATmega
+    {
+        test::reset();
+        using bus_t = twi_i2c<sa0::off_t, no_counter, registers>;
+        twi_peripheral<atmega328p_twi, pb0_t, pb2_t> twi;
+        virtual_display<pb0_t, pb2_t> panel;
+        bus_display<bus_t> disp{bus_t{twi_bitrate(16000000, 400000)},
+                                turn_on{}};
+        paint(disp);
+        CHECK(!std::memcmp(ref, panel.ctrl().gddram, sizeof ref));
+        CHECK_EQ(panel.stats().bytes, bitbang.bytes);
+        CHECK_EQ(panel.stats().races, 0u);
+        CHECK_EQ(registers::read(atmega328p_twi::twbr), 12);
+    }
+
+    //USI of the ATtiny, each write to USISR clears all flags
+    {
+        test::reset();
+        using bus_t = usi_i2c<pb0_t, pb2_t, sa0::off_t, no_counter,
+                              registers>;
+        usi_i2c_peripheral<attiny85_usi, pb0_t, pb2_t> usi;
+        virtual_display<pb0_t, pb2_t> panel;
+        unsigned writes{0}, partial{0};
+        auto handle = registers::instance().observe([&](uint16_t a, uint8_t v){
+            if(a != attiny85_usi::usisr) return;
+            ++writes;
+            if((v & 0xf0) != 0xf0) ++partial;
+        });
+        bus_display<bus_t> disp{bus_t{pb0, pb2}, turn_on{}};
+        paint(disp);
+        registers::instance().forget(handle);
+        CHECK(!std::memcmp(ref, panel.ctrl().gddram, sizeof ref));
+        CHECK_EQ(panel.stats().bytes, bitbang.bytes);
+        CHECK_EQ(panel.stats().races, 0u);
+        CHECK(writes > 0);
+        CHECK_EQ(partial, 0u);
+    }
+    return test::failures();
+}
@@ -0,0 +1,57 @@
+#include "check.hpp"
+
+#include <ssd1306.hpp>
+
+using namespace ssd1306;
+using namespace ssd1306::sim;
+
+static uint8_t a[1024], b[1024];
+
+template<typename D>
+static void prologue(D& disp) {
+    disp.out(page{5, 5}, column{3, 127}, uint8_t(0x3c), repeat<uint8_t>{20});
+}
+
+//GDDRAM and SCL clocks of one panel with its own bus.
+template<typename Sda>
+static uint32_t single(const uint8_t* image, uint8_t (&gddram)[8][128]) {
+    test::reset();
+    virtual_display<Sda, pb2_t> panel;
+    display<Sda, pb2_t> disp{Sda{}, pb2, turn_on{}};
+    prologue(disp);
+    auto before = panel.stats();
+    auto& bus = disp.device();
+    set(bus, page{0, 7}, column{0, 127});
+    bus.start_data();
+    for(uint16_t i{0}; i < 1024; ++i) bus.send_byte(image[i]);
+    bus.stop_condition();
+    uint32_t clocks = (panel.stats() - before).clocks;
+    std::memcpy(gddram, panel.ctrl().gddram, sizeof gddram);
+    return clocks;
+}
+
+int main() {
+    for(uint16_t i{0}; i < 1024; ++i) {
+        a[i] = uint8_t(i * 3);
+        b[i] = uint8_t(~(i * 5));
+    }
+    uint8_t ra[8][128], rb[8][128];
+    uint32_t clocks = single<pb0_t>(a, ra);
+    single<pb1_t>(b, rb);
+
+    //two panels with different images clocked by one SCL
+    test::reset();
+    virtual_display<pb0_t, pb2_t> pa;
+    virtual_display<pb1_t, pb2_t> pb;
+    multi_display<pb2_t, lanes<pb0_t, pb1_t>> disp{pb2, pb0, pb1, turn_on{}};
+    prologue(disp);
+    auto before = pa.stats();
+    const uint8_t* src[] = {a, b};
+    disp.out_lanes(page{0, 7}, column{0, 127}, src, 1024);
+    CHECK(!std::memcmp(ra, pa.ctrl().gddram, sizeof ra));
+    CHECK(!std::memcmp(rb, pb.ctrl().gddram, sizeof rb));
+    CHECK_EQ((pa.stats() - before).clocks, clocks);
+    CHECK_EQ(pa.stats().races, 0u);
+    CHECK_EQ(pb.stats().races, 0u);
+    return test::failures();
+}
@@ -0,0 +1,60 @@
+#include "check.hpp"
+
+#include <ssd1306.hpp>
+
+using namespace ssd1306;
+using namespace ssd1306::sim;
+
+//GDDRAM of 'v' drawn with send_int() at the page 0 and the column 'c'.
+template<typename UInt>
+static void reference(UInt v, uint8_t c, uint8_t (&gddram)[8][128]) {
+    test::reset();
+    virtual_display<pb0_t, pb2_t> panel;
+    display<pb0_t, pb2_t> disp{pb0, pb2};
+    auto& bus = disp.device();
+    set(bus, page{0, 3}, column{c, 127});
+    bus.start_data();
+    send_int<20, 32>(bus, v);
+    bus.stop_condition();
+    std::memcpy(gddram, panel.ctrl().gddram, sizeof gddram);
+}
+
+int main() {
+    uint8_t ref[8][128];
+
+    //an int is accepted and only the changed digits are sent
+    {
+        reference(uint16_t(1240), 0, ref);
+        test::reset();
+        virtual_display<pb0_t, pb2_t> panel;
+        display<pb0_t, pb2_t> disp{pb0, pb2};
+        numeric_field<20, 32> field{page{0}, column{0}};
+        int n{1234};
+        CHECK_EQ(field.update(disp.device(), n), 4);
+        auto before = panel.stats();
+        CHECK_EQ(field.update(disp.device(), n + 6), 4);
+        auto cost = panel.stats() - before;
+        CHECK(!std::memcmp(ref, panel.ctrl().gddram, sizeof ref));
+        //two cells of 25 columns and 4 pages, plus the window
+        CHECK(cost.bytes < 2 * 25 * 4 + 20);
+        //a shorter number clears the trailing cells
+        reference(uint8_t(7), 0, ref);
+        CHECK_EQ(field.update(disp.device(), uint8_t(7)), 1);
+        CHECK(!std::memcmp(ref, panel.ctrl().gddram, sizeof ref));
+    }
+
+    //the cells past the column 127 aren't drawn and nothing wraps
+    {
+        test::reset();
+        virtual_display<pb0_t, pb2_t> panel;
+        display<pb0_t, pb2_t> disp{pb0, pb2};
+        numeric_field<20, 32, 5, 5> field{page{0}, column{80}};
+        CHECK_EQ(field.update(disp.device(), uint16_t(12345)), 5);
+        //only the first cell fits in the columns 80 to 104
+        uint8_t got[8][128];
+        std::memcpy(got, panel.ctrl().gddram, sizeof got);
+        reference(uint8_t(1), 80, ref);
+        CHECK(!std::memcmp(ref, got, sizeof ref));
+    }
+    return test::failures();
+}
@@ -0,0 +1,49 @@
+#include "check.hpp"
+#include "images.hpp"
+
+#include <ssd1306.hpp>
+
+using namespace ssd1306;
+using namespace ssd1306::sim;
+
+constexpr uint8_t small[] = {1, 2, 3, 3, 3, 3, 4, 4, 5};
+
+int main() {
+    //known encoding: a literal run, two repeated runs and a literal run
+    using ps = packbits<small>;
+    const uint8_t expected[] = {1, 1, 2, 253, 3, 255, 4, 0, 5};
+    CHECK_EQ(ps::size, sizeof expected);
+    CHECK(!std::memcmp(ps::bytes.value, expected, sizeof expected));
+
+    using pk = packbits<image>;
+    CHECK_EQ(pk::raw_size, 1024);
+    CHECK(pk::size < pk::raw_size);
+
+    //for_each_packet() gives back the image
+    {
+        uint8_t raw[1024];
+        uint16_t n{0};
+        for_each_packet(pk::span(),
+            [&](const uint8_t* p, uint8_t k){ while(k--) raw[n++] = *p++; },
+            [&](uint8_t b, uint8_t k){ while(k--) raw[n++] = b; });
+        CHECK_EQ(n, 1024);
+        CHECK(!std::memcmp(raw, image, sizeof raw));
+    }
+
+    //GDDRAM round trip through display::out()
+    test::reset();
+    virtual_display<pb0_t, pb2_t> panel;
+    display<pb0_t, pb2_t> disp{pb0, pb2};
+    disp.out(page{0, 7}, column{0, 127}, pk::span());
+    CHECK(test::has_bytes(panel.ctrl(), image, 0, 7, 0, 127));
+
+    //and through send_packed() in a data transaction
+    disp.out(page{0, 7}, column{0, 127}, uint8_t(0), repeat<uint16_t>{1024});
+    using bus_t = i2c<pb0_t, pb2_t>;
+    set(bus_t{}, page{0, 7}, column{0, 127});
+    bus_t::start_data();
+    send_packed(bus_t{}, pk::span());
+    bus_t::stop_condition();
+    CHECK(test::has_bytes(panel.ctrl(), image, 0, 7, 0, 127));
+    return test::failures();
+}
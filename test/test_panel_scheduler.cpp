@@ -0,0 +1,74 @@
+#include "check.hpp"
+
+#include <ssd1306.hpp>
+
+using namespace ssd1306;
+using namespace ssd1306::sim;
+
+using bus0_t = i2c<pb0_t, pb2_t, sa0::off_t>;
+using bus1_t = i2c<pb0_t, pb2_t, sa0::on_t>;
+
+static uint8_t big[1024], label[3][64];
+
+static panel_update chart(uint8_t priority) {
+    return {page{0, 7}, column{0, 127},
+            transfer::ram(dc::data, big, 1024), priority};
+}
+
+int main() {
+    for(uint16_t i{0}; i < 1024; ++i) big[i] = uint8_t(i);
+    for(uint8_t k{0}; k < 3; ++k)
+        for(uint8_t i{0}; i < 64; ++i) label[k][i] = uint8_t(k * 40 + i);
+
+    virtual_display<pb0_t, pb2_t, sa0::off_t> v0;
+    virtual_display<pb0_t, pb2_t, sa0::on_t> v1;
+    bus_display<bus0_t> d0{bus0_t{pb0, pb2}};
+    bus_display<bus1_t> d1{bus1_t{pb0, pb2}};
+    panel_scheduler<bus0_t, bus1_t> s;
+    //a chunk of 32 bytes takes 4 ticks
+    const uint16_t chunk{32}, chunk_ticks{4};
+    uint16_t now{0};
+
+    //coalescing: the second label covers the first one
+    s.push(0, chart(5));
+    s.push(1, {page{2, 2}, column{0, 63},
+               transfer::ram(dc::data, label[0], 64), 0});
+    s.push(1, {page{2, 2}, column{0, 63},
+               transfer::ram(dc::data, label[1], 64), 0});
+    CHECK_EQ(s.pending(1), 1);
+
+    //aging: the panel 1 isn't starved by the panel 0 that redraws
+    //all the time with a greater priority
+    unsigned steps{0}, served{0};
+    while(steps < 200 && s.step(now, chunk, chunk_ticks)) {
+        ++steps;
+        now += chunk_ticks;
+        if(!served && !s.pending(1)) served = steps;
+        if(steps % 20 == 0) s.push(0, chart(5));
+    }
+    CHECK(served > 0 && served < 40);
+    while(s.step(now, chunk, chunk_ticks)) now += chunk_ticks;
+
+    //deadline: a timed update preempts the priority when its
+    //deadline expires before the end of the chunk, so the first
+    //chunk is of the panel 0 and the two chunks of the label follow
+    s.push(0, chart(9));
+    s.push(1, {page{3, 3}, column{0, 63},
+               transfer::ram(dc::data, label[2], 64), 0, true,
+               uint16_t(now + 2 * chunk_ticks - 1)});
+    steps = 0;
+    while(s.step(now, chunk, chunk_ticks)) {
+        ++steps;
+        now += chunk_ticks;
+        if(!s.pending(1)) break;
+    }
+    CHECK_EQ(steps, 3u);
+    CHECK(!s.pending(1));
+    CHECK(s.pending(0));
+    while(s.step(now, chunk, chunk_ticks)) now += chunk_ticks;
+
+    CHECK(test::has_bytes(v1.ctrl(), label[1], 2, 2, 0, 63));
+    CHECK(test::has_bytes(v1.ctrl(), label[2], 3, 3, 0, 63));
+    CHECK(test::has_bytes(v0.ctrl(), big, 0, 7, 0, 127));
+    return test::failures();
+}
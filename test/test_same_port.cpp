@@ -0,0 +1,48 @@
+#include "check.hpp"
+#include "images.hpp"
+
+#include <ssd1306.hpp>
+
+using namespace ssd1306;
+using namespace ssd1306::sim;
+
+struct cost { bus_stats bus; uint32_t writes; };
+
+//Draws the image and a number with SDA and SCL on the port 1.
+template<typename Sda, typename Scl>
+static cost send(uint8_t (&gddram)[8][128]) {
+    test::reset();
+    virtual_display<Sda, Scl> panel;
+    display<Sda, Scl> disp{Sda{}, Scl{}};
+    auto& bus = disp.device();
+    auto before = panel.stats();
+    auto writes = board::instance().writes();
+    set(bus, page{0, 7}, column{0, 127});
+    bus.start_data();
+    for(auto b : image) bus.send_byte(b);
+    bus.stop_condition();
+    set(bus, page{4, 7}, column{0, 127});
+    bus.start_data();
+    send_int<20, 32>(bus, uint16_t(1234));
+    bus.stop_condition();
+    std::memcpy(gddram, panel.ctrl().gddram, sizeof gddram);
+    return {panel.stats() - before, board::instance().writes() - writes};
+}
+
+int main() {
+    uint8_t generic[8][128], same[8][128];
+    auto g = send<plain_pin<1, 0>, plain_pin<1, 2>>(generic);
+    auto s = send<pb0_t, pb2_t>(same);
+
+    //both paths draw the same frame with the same bus traffic
+    CHECK(!std::memcmp(generic, same, sizeof same));
+    CHECK_EQ(g.bus.bytes, s.bus.bytes);
+    CHECK_EQ(g.bus.clocks, s.bus.clocks);
+    CHECK_EQ(s.bus.races, 0u);
+    //a bit costs at most three writes to the port instead of four
+    CHECK(s.writes < g.writes);
+    std::printf("port writes per bus byte: generic %.1f, same port %.1f\n",
+                double(g.writes) / g.bus.bytes,
+                double(s.writes) / s.bus.bytes);
+    return test::failures();
+}
@@ -0,0 +1,68 @@
+#include "check.hpp"
+
+#include <ssd1306.hpp>
+
+#include <vector>
+
+using namespace ssd1306;
+using namespace ssd1306::sim;
+
+//The bytes of the setups are computed at compile time.
+using left_t = horizontal_scroll<scroll_dir::left, 6, 7, 2>;
+static_assert(left_t::size == 7, "");
+static_assert(left_t::bytes[0] == 0x27 && left_t::bytes[1] == 0x00
+              && left_t::bytes[2] == 6 && left_t::bytes[3] == 7
+              && left_t::bytes[4] == 7 && left_t::bytes[5] == 0x00
+              && left_t::bytes[6] == 0xff, "");
+using diagonal_t = diagonal_scroll<scroll_dir::right, 0, 3, 1, 64>;
+static_assert(diagonal_t::size == 6, "");
+static_assert(diagonal_t::bytes[0] == 0x29 && diagonal_t::bytes[2] == 0
+              && diagonal_t::bytes[3] == 1 && diagonal_t::bytes[4] == 3
+              && diagonal_t::bytes[5] == 1, "");
+using area_t = vertical_scroll_area<0, 32>;
+static_assert(area_t::bytes[0] == 0xa3 && area_t::bytes[1] == 0
+              && area_t::bytes[2] == 32, "");
+
+static const uint8_t bytes[4] = {1, 2, 3, 4};
+
+int main() {
+    virtual_display<pb0_t, pb2_t> panel;
+    display<pb0_t, pb2_t> disp{pb0, pb2};
+    test::bus_recorder<pb0_t, pb2_t> rec;
+
+    //the scroll is deactivated before the setup and everything is
+    //one transaction
+    auto before = panel.stats();
+    disp.scroll(diagonal_t{}, area_t{});
+    CHECK_EQ((panel.stats() - before).starts, 1u);
+    std::vector<uint8_t> expected{0x2e, 0xa3, 0, 32,
+                                  0x29, 0x00, 0, 1, 3, 1, 0x2f};
+    CHECK(rec.commands == expected);
+    CHECK(disp.scrolling());
+    CHECK(panel.ctrl().scrolling);
+    CHECK_EQ(panel.ctrl().scroll_setup, 0x29);
+    CHECK_EQ(panel.ctrl().vscroll_rows, 32);
+
+    //a write stops the scroll before the GDDRAM is touched
+    rec.commands.clear();
+    disp.out(page{1, 1}, column{0, 3}, bytes);
+    CHECK(!disp.scrolling());
+    CHECK(!panel.ctrl().scrolling);
+    CHECK_EQ(panel.ctrl().writes_while_scrolling, 0u);
+    CHECK(!rec.commands.empty() && rec.commands[0] == 0x2e);
+    CHECK(test::has_bytes(panel.ctrl(), bytes, 1, 1, 0, 3));
+
+    //without a scroll, a write doesn't send 0x2e
+    rec.commands.clear();
+    disp.out(page{2, 2}, column{0, 3}, bytes);
+    for(auto c : rec.commands) CHECK(c != 0x2e);
+
+    //stop_scroll() and a new setup
+    disp.scroll(left_t{});
+    CHECK_EQ(panel.ctrl().scroll_setup, 0x27);
+    CHECK(panel.ctrl().scrolling);
+    disp.stop_scroll();
+    CHECK(!panel.ctrl().scrolling);
+    CHECK(!disp.scrolling());
+    return test::failures();
+}
@@ -0,0 +1,60 @@
+#include "check.hpp"
+#include "legacy.hpp"
+
+#include <ssd1306.hpp>
+
+using namespace ssd1306;
+using namespace ssd1306::sim;
+
+//Digits from the flash patterns send the bytes of the branches.
+template<uint8_t w, uint8_t h, uint8_t spacing>
+static void check_digits() {
+    for(uint8_t s{0}; s < 128; ++s) {
+        test::recorder before, after;
+        legacy::send_digit_segmented<w, h, spacing>(before, s);
+        send_digit_segmented<w, h, spacing>(after, s);
+        CHECK(before.bytes == after.bytes);
+    }
+    for(uint8_t d{0}; d < 10; ++d) {
+        test::recorder before, after;
+        legacy::send_digit<w, h, spacing>(before, d);
+        send_digit<w, h, spacing>(after, d);
+        CHECK(before.bytes == after.bytes);
+    }
+}
+
+//Bus cost of the digits 0 to 9 sent with one window.
+template<typename F>
+static bus_stats digits_cost(F send, uint8_t (&gddram)[8][128]) {
+    test::reset();
+    virtual_display<pb0_t, pb2_t> panel;
+    display<pb0_t, pb2_t> disp{pb0, pb2};
+    auto& bus = disp.device();
+    auto before = panel.stats();
+    set(bus, page{0, 3}, column{0, 127});
+    bus.start_data();
+    for(uint8_t d{0}; d < 10; ++d) send(bus, d);
+    bus.stop_condition();
+    std::memcpy(gddram, panel.ctrl().gddram, sizeof gddram);
+    return panel.stats() - before;
+}
+
+int main() {
+    check_digits<12, 16, 3>();
+    check_digits<20, 32, 5>();
+    check_digits<13, 48, 0>();
+    check_digits<64, 64, 2>();
+
+    uint8_t ref[8][128], got[8][128];
+    auto old = digits_cost([](auto& bus, uint8_t d)
+                           { legacy::send_digit<12, 32, 1>(bus, d); }, ref);
+    auto now = digits_cost([](auto& bus, uint8_t d)
+                           { send_digit<12, 32, 1>(bus, d); }, got);
+    std::printf("bus cost of ten digits: bytes %u(baseline %u), "
+                "clocks %u(baseline %u)\n",
+                now.bytes, old.bytes, now.clocks, old.clocks);
+    CHECK_EQ(now.bytes, old.bytes);
+    CHECK_EQ(now.clocks, old.clocks);
+    CHECK(!std::memcmp(ref, got, sizeof ref));
+    return test::failures();
+}
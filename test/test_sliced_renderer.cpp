@@ -0,0 +1,69 @@
+#include "check.hpp"
+
+#include <ssd1306.hpp>
+
+using namespace ssd1306;
+using namespace ssd1306::sim;
+
+//GDDRAM of 'v' drawn with send_int() at the page 0 and the column 'c'.
+template<typename UInt>
+static void reference(UInt v, uint8_t c, uint8_t (&gddram)[8][128]) {
+    test::reset();
+    virtual_display<pb0_t, pb2_t> panel;
+    display<pb0_t, pb2_t> disp{pb0, pb2};
+    auto& bus = disp.device();
+    set(bus, page{0, 3}, column{c, 127});
+    bus.start_data();
+    send_int<20, 32>(bus, v);
+    bus.stop_condition();
+    std::memcpy(gddram, panel.ctrl().gddram, sizeof gddram);
+}
+
+//GDDRAM of 'v' drawn by a sliced_renderer in slices of 'chunk'.
+template<bool KeepOpen, typename UInt>
+static void sliced(UInt v, uint8_t c, uint16_t chunk,
+                   uint8_t (&gddram)[8][128])
+{
+    test::reset();
+    virtual_display<pb0_t, pb2_t> panel;
+    display<pb0_t, pb2_t> disp{pb0, pb2};
+    sliced_renderer<i2c<pb0_t, pb2_t>, KeepOpen> r;
+    r.template digits<20, 32>(page{0}, column{c}, v);
+    while(r.step(chunk));
+    CHECK(!r.busy());
+    std::memcpy(gddram, panel.ctrl().gddram, sizeof gddram);
+}
+
+int main() {
+    uint8_t ref[8][128], got[8][128];
+
+    //the digits stop at the number of digits of the value
+    reference(uint16_t(42), 0, ref);
+    sliced<false>(uint16_t(42), 0, 7, got);
+    CHECK(!std::memcmp(ref, got, sizeof ref));
+    sliced<true>(uint16_t(42), 0, 7, got);
+    CHECK(!std::memcmp(ref, got, sizeof ref));
+
+    reference(uint32_t(1234), 3, ref);
+    sliced<false>(uint32_t(1234), 3, 16, got);
+    CHECK(!std::memcmp(ref, got, sizeof ref));
+
+    //only the first digit fits in the columns 80 to 104
+    reference(uint8_t(1), 80, ref);
+    sliced<false>(uint16_t(12345), 80, 16, got);
+    CHECK(!std::memcmp(ref, got, sizeof ref));
+
+    //no digit fits, nothing is sent
+    {
+        test::reset();
+        virtual_display<pb0_t, pb2_t> panel;
+        display<pb0_t, pb2_t> disp{pb0, pb2};
+        sliced_renderer<i2c<pb0_t, pb2_t>> r;
+        auto before = panel.stats();
+        r.digits<20, 32>(page{0}, column{110}, uint8_t(7));
+        CHECK(!r.busy());
+        CHECK(!r.step(16));
+        CHECK_EQ((panel.stats() - before).bytes, 0u);
+    }
+    return test::failures();
+}
@@ -0,0 +1,80 @@
+#include "check.hpp"
+
+#include <ssd1306.hpp>
+
+using namespace ssd1306;
+using namespace ssd1306::sim;
+
+template<typename D>
+static void paint(D& disp) {
+    static const uint8_t bytes[] = {1, 2, 3, 4, 0xff};
+    disp.template out<20, 32>(page{0, 3}, column{0, 127}, -1234);
+    disp.out(page{5, 5}, column{3, 127}, bytes);
+    disp.out(page{6, 7}, column{0, 63}, uint8_t(0xaa), repeat<uint8_t>{128});
+}
+
+//The panel got the frame of I2C with the same data bytes and eight
+//clocks to each byte.
+template<typename Panel>
+static void check(const Panel& panel, const uint8_t (&ref)[8][128],
+                  uint32_t data_bytes, const spi_stats& before)
+{
+    CHECK(!std::memcmp(ref, panel.ctrl().gddram, sizeof ref));
+    CHECK_EQ(panel.ctrl().data_bytes, data_bytes);
+    auto cost = panel.stats() - before;
+    CHECK(cost.selects > 0);
+    CHECK_EQ(cost.clocks, 8 * cost.bytes);
+}
+
+int main() {
+    //reference: the bit-banged I2C
+    uint8_t ref[8][128];
+    uint32_t data_bytes;
+    {
+        virtual_display<pb0_t, pb2_t> panel;
+        display<pb0_t, pb2_t> disp{pb0, pb2, turn_on{}};
+        paint(disp);
+        std::memcpy(ref, panel.ctrl().gddram, sizeof ref);
+        data_bytes = panel.ctrl().data_bytes;
+    }
+
+    //bit-banged SPI: SCLK pb5, SDIN pb3, D/C# pb1 and CS# pb2
+    spi_stats bitbang;
+    {
+        test::reset();
+        using bus_t = spi<pb5_t, pb3_t, pb1_t, pb2_t>;
+        virtual_spi_display<pb5_t, pb3_t, pb1_t, pb2_t> panel;
+        bus_display<bus_t> disp{bus_t{pb5, pb3, pb1, pb2}, turn_on{}};
+        auto before = panel.stats();
+        paint(disp);
+        check(panel, ref, data_bytes, before);
+        bitbang = panel.stats() - before;
+    }
+
+    //SPI of the ATmega
+    {
+        test::reset();
+        using bus_t = hw_spi<pb1_t, pb2_t, registers>;
+        virtual_hw_spi_display<atmega328p_spi, pb1_t, pb2_t> panel;
+        bus_display<bus_t> disp{bus_t{pb5, pb3, pb1, pb2}, turn_on{}};
+        auto before = panel.stats();
+        paint(disp);
+        check(panel, ref, data_bytes, before);
+        CHECK_EQ((panel.stats() - before).bytes, bitbang.bytes);
+        CHECK_EQ((panel.stats() - before).selects, bitbang.selects);
+    }
+
+    //USI of the ATtiny
+    {
+        test::reset();
+        using bus_t = usi_spi<pb1_t, pb2_t, registers>;
+        virtual_usi_spi_display<attiny85_usi, pb1_t, pb2_t> panel;
+        bus_display<bus_t> disp{bus_t{pb5, pb3, pb1, pb2}, turn_on{}};
+        auto before = panel.stats();
+        paint(disp);
+        check(panel, ref, data_bytes, before);
+        CHECK_EQ((panel.stats() - before).bytes, bitbang.bytes);
+        CHECK_EQ((panel.stats() - before).selects, bitbang.selects);
+    }
+    return test::failures();
+}
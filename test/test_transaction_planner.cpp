@@ -0,0 +1,114 @@
+#include "check.hpp"
+
+#include <ssd1306.hpp>
+
+using namespace ssd1306;
+using namespace ssd1306::sim;
+
+using bus_t = i2c<pb0_t, pb2_t>;
+
+static const uint8_t window[] = {0x22, 2, 3, 0x21, 10, 19};
+static const uint8_t position[] = {0xb4, 0x05, 0x10};
+static const uint8_t bytes[20] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
+                                  11, 12, 13, 14, 15, 16, 17, 18, 19, 20};
+
+//Sends the segments one transaction each.
+template<uint8_t N>
+static void send_apart(const bus_segment (&segs)[N]) {
+    bus_t bus;
+    for(auto& s : segs) {
+        if(s.mode == dc::command) bus.start_commands();
+        else bus.start_data();
+        for(uint8_t i{0}; i < s.size; ++i) bus.send_byte(s.bytes[i]);
+        bus.stop_condition();
+    }
+}
+
+//The predicted clocks are the decoded ones and the GDDRAM is the same
+//of one transaction to each segment.
+template<uint8_t N>
+static void check_plan(const bus_segment (&segs)[N]) {
+    uint8_t ref[8][128];
+    {
+        test::reset();
+        virtual_display<pb0_t, pb2_t> panel;
+        display<pb0_t, pb2_t> disp{pb0, pb2};
+        send_apart(segs);
+        std::memcpy(ref, panel.ctrl().gddram, sizeof ref);
+    }
+    test::reset();
+    virtual_display<pb0_t, pb2_t> panel;
+    display<pb0_t, pb2_t> disp{pb0, pb2};
+    auto before = panel.stats();
+    auto predicted = send_segments(bus_t{}, segs);
+    auto cost = panel.stats() - before;
+    CHECK_EQ(cost.clocks, predicted);
+    CHECK(!std::memcmp(ref, panel.ctrl().gddram, sizeof ref));
+}
+
+int main() {
+    //windows and page addressing followed by a few bytes
+    check_plan({bus_segment{dc::command, window, 3},
+                bus_segment{dc::command, window + 3, 3},
+                bus_segment{dc::command, position, 3},
+                bus_segment{dc::data, bytes, 4}});
+    //a window followed by data: two transactions
+    check_plan({bus_segment{dc::command, window, 6},
+                bus_segment{dc::data, bytes, 20}});
+    //mixed
+    check_plan({bus_segment{dc::command, window, 6},
+                bus_segment{dc::data, bytes, 5},
+                bus_segment{dc::command, window, 3},
+                bus_segment{dc::data, bytes + 5, 2},
+                bus_segment{dc::data, bytes + 7, 13}});
+
+    //the plan of a window and data is two transactions
+    {
+        bus_segment segs[] = {bus_segment{dc::command, window, 6},
+                              bus_segment{dc::data, bytes, 20}};
+        uint8_t from[3];
+        CHECK_EQ(plan(segs, from),
+                 detail::transaction_clocks(segs, 0, 0)
+                 + detail::transaction_clocks(segs, 1, 1));
+        CHECK_EQ(from[2], 1);
+    }
+
+    //merging k command bytes costs 9k clocks of control bytes and a
+    //transaction of its own costs 19 clocks(address, control byte and
+    //stop), so up to two command bytes share the transaction of the
+    //data
+    {
+        const uint16_t clocks[] = {55, 73, 83};
+        for(uint8_t k{1}; k <= 3; ++k) {
+            bus_segment segs[] = {bus_segment{dc::command, position, k},
+                                  bus_segment{dc::data, bytes, 2}};
+            uint8_t from[3];
+            CHECK_EQ(plan(segs, from), clocks[k - 1]);
+            CHECK_EQ(from[2], k <= 2 ? 0 : 1);
+            test::reset();
+            virtual_display<pb0_t, pb2_t> panel;
+            display<pb0_t, pb2_t> disp{pb0, pb2};
+            auto before = panel.stats();
+            send_segments(bus_t{}, segs);
+            auto cost = panel.stats() - before;
+            CHECK_EQ(cost.starts, k <= 2 ? 1u : 2u);
+        }
+        check_plan({bus_segment{dc::command, position, 2},
+                    bus_segment{dc::data, bytes, 2}});
+        check_plan({bus_segment{dc::command, position, 3},
+                    bus_segment{dc::data, bytes, 2}});
+    }
+
+    //start_segments() leaves the data transaction open
+    {
+        test::reset();
+        virtual_display<pb0_t, pb2_t> panel;
+        display<pb0_t, pb2_t> disp{pb0, pb2};
+        bus_t bus;
+        start_segments(bus, {bus_segment{dc::command, window, 6}}, dc::data);
+        for(auto b : bytes) bus.send_byte(b);
+        bus.stop_condition();
+        CHECK(test::has_bytes(panel.ctrl(), bytes, 2, 3, 10, 19));
+    }
+    return test::failures();
+}
@@ -0,0 +1,136 @@
+#include "check.hpp"
+
+#include <ssd1306.hpp>
+
+#include <random>
+
+using namespace ssd1306;
+using namespace ssd1306::sim;
+
+//The same operations go to a display with 'window_cache', on pb0, and
+//to a display with 'no_window_cache', on pb1, and both GDDRAMs must
+//be equal after each one. Each display has its own SCL, because a
+//decoder sees clocks of the other bus as bytes while it waits for the
+//next start condition.
+using cached_t = display<pb0_t, pb2_t>;
+using plain_t = display<pb1_t, pb3_t, sa0::off_t, no_counter,
+                        no_window_cache>;
+
+static uint8_t buf[1024];
+
+struct panels {
+    virtual_display<pb0_t, pb2_t> cached_panel;
+    virtual_display<pb1_t, pb3_t> plain_panel;
+    cached_t cached{pb0, pb2};
+    plain_t plain{pb1, pb3};
+
+    template<typename F>
+    bool apply(F op) {
+        op(cached);
+        op(plain);
+        return test::same_gddram(cached_panel.ctrl(), plain_panel.ctrl());
+    }
+};
+
+int main() {
+    for(uint16_t i{0}; i < 1024; ++i) buf[i] = uint8_t(i * 37 + (i >> 7));
+
+    //a write without a window continues the one of four bytes
+    {
+        panels p;
+        const uint8_t four[4] = {1, 2, 3, 4};
+        const uint8_t eight[8] = {5, 6, 7, 8, 9, 10, 11, 12};
+        CHECK(p.apply([&](auto& d)
+                      { d.out(page{2, 2}, column{10, 13}, four); }));
+        CHECK(p.apply([&](auto& d){ d.out(eight); }));
+        CHECK(p.apply([&](auto& d){ d.out(four); }));
+        CHECK(p.apply([&](auto& d)
+                      { d.out(page{2, 2}, column{10, 13}, four); }));
+        CHECK(p.apply([&](auto& d){ d.out(four); }));
+        CHECK(p.apply([&](auto& d){ d.template out<12, 16>(uint8_t(42)); }));
+    }
+
+    //random operations
+    test::reset();
+    panels p;
+    std::mt19937 rng{1234};
+    auto rnd = [&](uint16_t n){ return uint16_t(rng() % n); };
+    auto before_cached = p.cached_panel.stats();
+    auto before_plain = p.plain_panel.stats();
+    unsigned failed_at{0};
+    for(unsigned i{1}; i <= 5000 && !failed_at; ++i) {
+        uint8_t p0 = rnd(8), p1 = rnd(2) ? p0 : p0 + rnd(8 - p0);
+        uint8_t c0 = rnd(128), c1 = c0 + rnd(128 - c0);
+        page pg{p0, p1};
+        column col{c0, c1};
+        uint16_t size = (p1 - p0 + 1) * (c1 - c0 + 1);
+        uint16_t n = rnd(3) ? size : 1 + rnd(300);
+        if(n > 1024) n = 1024;
+        flash_bytes src{buf + rnd(1024 - n + 1), n};
+        uint8_t byte = rnd(256);
+        int32_t value = int32_t(rng() % 200000) - 100000;
+        bool same{true};
+        switch(rnd(10)) {
+        case 0: same = p.apply([&](auto& d){ d.out(pg, col, src); }); break;
+        case 1: same = p.apply([&](auto& d){ d.out(src); }); break;
+        case 2: same = p.apply([&](auto& d){ d.out(pg, src); }); break;
+        case 3: same = p.apply([&](auto& d){ d.out(col, src); }); break;
+        case 4:
+            same = p.apply([&](auto& d)
+                           { d.out(pg, col, byte, repeat<uint16_t>{n}); });
+            break;
+        case 5:
+            same = p.apply([&](auto& d){ d.out(byte, repeat<uint16_t>{n}); });
+            break;
+        case 6:
+            same = p.apply([&](auto& d)
+                           { d.out(page{p0, p0}, col, "Menu 12"); });
+            break;
+        case 7:
+            same = p.apply([&](auto& d)
+                           { d.template out<12, 16>(pg, col, value); });
+            break;
+        case 8:
+            same = p.apply([&](auto& d){ d.template out<12, 16>(byte); });
+            break;
+        case 9:
+            same = p.apply([&](auto& d){
+                auto& bus = d.device();
+                set(bus, pg, col);
+                bus.start_data();
+                for(uint8_t k{0}; k < 10; ++k) bus.send_byte(buf[k]);
+                bus.stop_condition();
+            });
+            break;
+        }
+        if(!same) failed_at = i;
+    }
+    CHECK_EQ(failed_at, 0u);
+    auto cached = p.cached_panel.stats() - before_cached;
+    auto plain = p.plain_panel.stats() - before_plain;
+    std::printf("random operations, bus bytes with window_cache %u, "
+                "no_window_cache %u\n", cached.bytes, plain.bytes);
+
+    //labels of one page and redraws of the same window are cheaper
+    test::reset();
+    panels q;
+    before_cached = q.cached_panel.stats();
+    before_plain = q.plain_panel.stats();
+    for(uint8_t i{0}; i < 100; ++i) {
+        uint8_t c = i % 8 * 16;
+        flash_bytes label{buf + i, 16};
+        CHECK(q.apply([&](auto& d)
+                      { d.out(page{uint8_t(i % 8)}, column{c, uint8_t(c + 15)},
+                              label); }));
+    }
+    for(uint8_t i{0}; i < 100; ++i)
+        CHECK(q.apply([&](auto& d)
+                      { d.out(page{0, 1}, column{0, 63},
+                              flash_bytes{buf + i, 128}); }));
+    cached = q.cached_panel.stats() - before_cached;
+    plain = q.plain_panel.stats() - before_plain;
+    std::printf("labels, bus bytes with window_cache %u, "
+                "no_window_cache %u\n", cached.bytes, plain.bytes);
+    CHECK(cached.bytes < plain.bytes);
+    return test::failures();
+}